@@ -6,6 +6,32 @@
 #include <map>
 #include <iomanip>
 #include <cmath>
+#include <sstream>
+#include <ctime>
+#include <random>
+#include <thread>
+#include <fstream>
+#include <chrono>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <shared_mutex>
+#include <unistd.h>
+#include <poll.h>
+#include <signal.h>
+#include <sys/wait.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/file.h>
+#include <sys/prctl.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+#include <fcntl.h>
+#include <cstring>
+#include <cstdint>
+#include <climits>
+#include <new>
 
 using namespace std;
 
@@ -58,6 +84,407 @@ double convertCurrency(double amount, const string& fromCurrency, const string&
     return inBase * rates[toCurrency];
 }
 
+// --------------------- CustomerStore ---------------------
+// Persistent customer profiles keyed by the 10-digit phone number, kept in a
+// memory-mapped file laid out as
+//   [header][slot table: open addressing, linear probing][overflow strings]
+// Each slot holds two copies of its profile plus an index of the active one.
+// Writers fill the inactive copy, flush it, then flip the index, so a crash
+// leaves either the old or the new profile, never a torn one. Readers take no
+// file locks: a per-copy sequence number (odd while being written) lets them
+// retry if a writer raced them. Writers serialise on flock(), so several
+// planner processes can share one file. Names and emails are appended to the
+// overflow area and never rewritten in place; when the table passes 70% load
+// or the overflow area fills, the file is rebuilt at double size and renamed
+// over the original. The old file is marked retired just before the rename,
+// and lookups that see the mark follow the path to the new file; within one
+// process a reader/writer lock keeps lookups off a mapping while it is being
+// swapped. The file holds personal details, so it is
+// created readable by its owner only.
+struct CustomerProfile {
+    string name, email;
+    int lastAdults, lastChildren;
+    unsigned int visits;
+    unsigned int purposeCounts[4]; // family, couple, friends, solo
+
+    string favouritePurpose() const {
+        static const char* purposes[4] = {"family", "couple", "friends", "solo"};
+        int best = 0;
+        for (int i = 1; i < 4; i++) {
+            if (purposeCounts[i] > purposeCounts[best]) best = i;
+        }
+        return purposes[best];
+    }
+};
+
+class CustomerStore {
+private:
+    struct StoreHeader {
+        char magic[8];
+        uint32_t version;
+        uint32_t slotSize;
+        uint64_t capacity;         // Slots, power of two
+        uint64_t overflowCapacity; // Bytes
+        atomic<uint64_t> count;
+        atomic<uint64_t> overflowUsed;
+        atomic<uint32_t> retired;  // Set once a rebuilt file replaces this one
+    };
+
+    struct ProfileCopy {
+        atomic<uint32_t> seq;      // Odd while the copy is being written
+        uint16_t adults, children;
+        uint64_t nameOffset, emailOffset;
+        uint32_t nameLength, emailLength;
+        uint32_t visits;
+        uint32_t purposeCounts[4];
+    };
+
+    struct Slot {
+        atomic<uint64_t> key;      // Phone number + 1; 0 marks an empty slot
+        atomic<uint32_t> active;   // Which copy readers should use
+        uint32_t reserved;
+        ProfileCopy copies[2];
+    };
+
+    static const size_t headerSize = 4096;
+    static const uint64_t initialCapacity = 1024;
+    static const uint64_t initialOverflow = 64 * 1024;
+
+    string path;
+    // The current mapping; lookups may follow a rebuilt file, hence mutable
+    mutable int fd;
+    mutable char* base;
+    mutable size_t mappedSize;
+    mutable ino_t mappedInode;
+    // Shared by lookups; exclusive for writes and remaps, since flock() does
+    // not exclude threads of one process
+    mutable shared_mutex mappingMutex;
+
+    StoreHeader* header() const { return (StoreHeader*)base; }
+    Slot* slots() const { return (Slot*)(base + headerSize); }
+    char* overflow() const { return base + headerSize + header()->capacity * sizeof(Slot); }
+
+    static uint64_t mix(uint64_t x) {
+        x += 0x9E3779B97F4A7C15ull;
+        x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+        x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+        return x ^ (x >> 31);
+    }
+
+    static size_t fileSizeFor(uint64_t capacity, uint64_t overflowCapacity) {
+        return headerSize + capacity * sizeof(Slot) + overflowCapacity;
+    }
+
+    void flush(void* address, size_t length) const {
+        // msync needs a page-aligned start
+        uintptr_t start = (uintptr_t)address & ~(uintptr_t)4095;
+        msync((void*)start, (uintptr_t)address + length - start, MS_SYNC);
+    }
+
+    static bool createFile(const string& filePath, uint64_t capacity, uint64_t overflowCapacity) {
+        int newFd = ::open(filePath.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0600);
+        if (newFd < 0) return false;
+        size_t size = fileSizeFor(capacity, overflowCapacity);
+        // O_CREAT's mode does not apply to a leftover file from an earlier crash
+        if (fchmod(newFd, 0600) != 0 || ftruncate(newFd, size) != 0) {
+            ::close(newFd);
+            return false;
+        }
+        void* mem = mmap(NULL, headerSize, PROT_READ | PROT_WRITE, MAP_SHARED, newFd, 0);
+        if (mem == MAP_FAILED) {
+            ::close(newFd);
+            return false;
+        }
+        StoreHeader* h = (StoreHeader*)mem;
+        memcpy(h->magic, "WPCUST1", 8);
+        h->version = 1;
+        h->slotSize = sizeof(Slot);
+        h->capacity = capacity;
+        h->overflowCapacity = overflowCapacity;
+        h->count.store(0);
+        h->overflowUsed.store(0);
+        h->retired.store(0);
+        msync(mem, headerSize, MS_SYNC);
+        munmap(mem, headerSize);
+        ::close(newFd);
+        return true;
+    }
+
+    bool mapFile() const {
+        fd = ::open(path.c_str(), O_RDWR);
+        if (fd < 0) return false;
+        struct stat info;
+        if (fstat(fd, &info) != 0 || (size_t)info.st_size < headerSize) {
+            unmap();
+            return false;
+        }
+        mappedSize = info.st_size;
+        mappedInode = info.st_ino;
+        void* mem = mmap(NULL, mappedSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (mem == MAP_FAILED) {
+            base = NULL;
+            unmap();
+            return false;
+        }
+        base = (char*)mem;
+        StoreHeader* h = header();
+        if (memcmp(h->magic, "WPCUST1", 8) != 0 || h->slotSize != sizeof(Slot) ||
+            fileSizeFor(h->capacity, h->overflowCapacity) != mappedSize) {
+            unmap();
+            return false;
+        }
+        return true;
+    }
+
+    void unmap() const {
+        if (base != NULL) munmap(base, mappedSize);
+        if (fd >= 0) ::close(fd);
+        base = NULL;
+        fd = -1;
+        mappedSize = 0;
+    }
+
+    // Another process may have rebuilt the file; follow it to the new inode.
+    // Callers hold mappingMutex exclusively.
+    bool remapIfReplaced() const {
+        struct stat info;
+        if (stat(path.c_str(), &info) != 0) return false;
+        if (base != NULL && info.st_ino == mappedInode) return true;
+        unmap();
+        return mapFile();
+    }
+
+    Slot* findSlot(uint64_t key) const {
+        uint64_t mask = header()->capacity - 1;
+        for (uint64_t i = mix(key) & mask, probes = 0; probes <= mask; i = (i + 1) & mask, probes++) {
+            uint64_t current = slots()[i].key.load(memory_order_acquire);
+            if (current == key || current == 0) return &slots()[i];
+        }
+        return NULL;
+    }
+
+    // Lock-free consistent snapshot of a slot's active copy
+    static void readCopy(const Slot* slot, ProfileCopy& out) {
+        while (true) {
+            const ProfileCopy& copy = slot->copies[slot->active.load(memory_order_acquire)];
+            uint32_t before = copy.seq.load(memory_order_acquire);
+            if (before & 1) continue;
+            out.adults = copy.adults;
+            out.children = copy.children;
+            out.nameOffset = copy.nameOffset;
+            out.emailOffset = copy.emailOffset;
+            out.nameLength = copy.nameLength;
+            out.emailLength = copy.emailLength;
+            out.visits = copy.visits;
+            memcpy(out.purposeCounts, copy.purposeCounts, sizeof(out.purposeCounts));
+            atomic_thread_fence(memory_order_acquire);
+            if (copy.seq.load(memory_order_relaxed) == before) return;
+        }
+    }
+
+    // Appends a string to the overflow area; returns false when it is full.
+    // A rebuild passes sync = false and flushes the whole file once at the end.
+    bool appendString(const string& text, uint64_t& offset, bool sync = true) {
+        StoreHeader* h = header();
+        uint64_t used = h->overflowUsed.load();
+        if (used + text.size() > h->overflowCapacity) return false;
+        memcpy(overflow() + used, text.data(), text.size());
+        if (sync) flush(overflow() + used, max<size_t>(1, text.size()));
+        offset = used;
+        h->overflowUsed.store(used + text.size());
+        return true;
+    }
+
+    // Rebuilds the store at a larger size and atomically swaps it in
+    bool grow(uint64_t newCapacity, uint64_t newOverflow) {
+        string tmpPath = path + ".tmp";
+        if (!createFile(tmpPath, newCapacity, newOverflow)) return false;
+        CustomerStore target;
+        target.path = tmpPath;
+        if (!target.mapFile()) return false;
+
+        for (uint64_t i = 0; i < header()->capacity; i++) {
+            uint64_t key = slots()[i].key.load(memory_order_acquire);
+            if (key == 0) continue;
+            ProfileCopy copy;
+            readCopy(&slots()[i], copy);
+            string name(overflow() + copy.nameOffset, copy.nameLength);
+            string email(overflow() + copy.emailOffset, copy.emailLength);
+            Slot* slot = target.findSlot(key);
+            if (!target.appendString(name, copy.nameOffset, false) ||
+                !target.appendString(email, copy.emailOffset, false)) {
+                return false;
+            }
+            slot->copies[0].adults = copy.adults;
+            slot->copies[0].children = copy.children;
+            slot->copies[0].nameOffset = copy.nameOffset;
+            slot->copies[0].emailOffset = copy.emailOffset;
+            slot->copies[0].nameLength = copy.nameLength;
+            slot->copies[0].emailLength = copy.emailLength;
+            slot->copies[0].visits = copy.visits;
+            memcpy(slot->copies[0].purposeCounts, copy.purposeCounts, sizeof(copy.purposeCounts));
+            slot->active.store(0);
+            slot->key.store(key, memory_order_release);
+            target.header()->count++;
+        }
+        msync(target.base, target.mappedSize, MS_SYNC);
+        target.unmap();
+
+        // Readers of the old file go looking for the new one from here on;
+        // until the rename lands they find this file again, which is still current
+        header()->retired.store(1, memory_order_release);
+        flush(header(), sizeof(StoreHeader));
+        if (rename(tmpPath.c_str(), path.c_str()) != 0) {
+            header()->retired.store(0, memory_order_release);
+            return false;
+        }
+        // Keep holding the old file's lock until the new file is in place
+        int oldFd = fd;
+        fd = -1;
+        unmap();
+        bool ok = mapFile();
+        ::close(oldFd);
+        return ok;
+    }
+
+    // Reads the profile for `key` from the current mapping; callers hold mappingMutex
+    bool readProfile(uint64_t key, CustomerProfile& profile) const {
+        Slot* slot = findSlot(key);
+        if (slot == NULL || slot->key.load(memory_order_acquire) != key) return false;
+        ProfileCopy copy;
+        readCopy(slot, copy);
+        profile.name.assign(overflow() + copy.nameOffset, copy.nameLength);
+        profile.email.assign(overflow() + copy.emailOffset, copy.emailLength);
+        profile.lastAdults = copy.adults;
+        profile.lastChildren = copy.children;
+        profile.visits = copy.visits;
+        memcpy(profile.purposeCounts, copy.purposeCounts, sizeof(copy.purposeCounts));
+        return true;
+    }
+
+public:
+    CustomerStore() : fd(-1), base(NULL), mappedSize(0), mappedInode(0) {}
+    ~CustomerStore() { close(); }
+
+    bool open(const string& filePath) {
+        close();
+        unique_lock<shared_mutex> guard(mappingMutex);
+        path = filePath;
+        if (access(path.c_str(), F_OK) != 0 && !createFile(path, initialCapacity, initialOverflow)) {
+            return false;
+        }
+        return mapFile();
+    }
+
+    void close() {
+        unique_lock<shared_mutex> guard(mappingMutex);
+        unmap();
+    }
+
+    bool isOpen() const {
+        shared_lock<shared_mutex> guard(mappingMutex);
+        return base != NULL;
+    }
+
+    size_t size() const {
+        shared_lock<shared_mutex> guard(mappingMutex);
+        return base != NULL ? header()->count.load() : 0;
+    }
+
+    static bool phoneKey(const string& number, uint64_t& key) {
+        if (!isValidNumber(number)) return false;
+        key = stoull(number) + 1;
+        return true;
+    }
+
+    bool lookup(const string& number, CustomerProfile& profile) const {
+        uint64_t key;
+        if (!phoneKey(number, key)) return false;
+        {
+            shared_lock<shared_mutex> reading(mappingMutex);
+            if (base == NULL) return false;
+            if (!header()->retired.load(memory_order_acquire)) return readProfile(key, profile);
+        }
+        // Another process has rebuilt the file since we mapped it; hits here
+        // could be stale and new customers are only in the new file
+        unique_lock<shared_mutex> writing(mappingMutex);
+        return remapIfReplaced() && readProfile(key, profile);
+    }
+
+    bool recordVisit(const string& number, const string& name, const string& email,
+                     int adults, int children, const string& tripPurpose) {
+        uint64_t key;
+        if (!phoneKey(number, key)) return false;
+        unique_lock<shared_mutex> guard(mappingMutex);
+        if (base == NULL || !remapIfReplaced()) return false;
+        flock(fd, LOCK_EX);
+        // The file may have been replaced while we waited for the lock
+        while (true) {
+            struct stat info;
+            if (stat(path.c_str(), &info) != 0) { flock(fd, LOCK_UN); return false; }
+            if (info.st_ino == mappedInode) break;
+            flock(fd, LOCK_UN);
+            if (!remapIfReplaced()) return false;
+            flock(fd, LOCK_EX);
+        }
+
+        bool ok = false;
+        while (true) {
+            StoreHeader* h = header();
+            Slot* slot = findSlot(key);
+            bool isNew = slot == NULL || slot->key.load() != key;
+            bool needsRoom = (isNew && (h->count.load() + 1) * 10 > h->capacity * 7) ||
+                             h->overflowUsed.load() + name.size() + email.size() > h->overflowCapacity;
+            if (needsRoom) {
+                uint64_t liveBytes = h->overflowUsed.load() + name.size() + email.size();
+                if (!grow(h->capacity * 2, max<uint64_t>(h->overflowCapacity * 2, liveBytes * 2))) break;
+                flock(fd, LOCK_EX);
+                continue;
+            }
+
+            ProfileCopy current = {};
+            current.nameOffset = current.emailOffset = 0;
+            if (!isNew) readCopy(slot, current);
+            string storedName = isNew ? "" : string(overflow() + current.nameOffset, current.nameLength);
+            string storedEmail = isNew ? "" : string(overflow() + current.emailOffset, current.emailLength);
+
+            uint32_t target = isNew ? 0 : 1 - slot->active.load();
+            ProfileCopy& copy = slot->copies[target];
+            copy.seq.store(copy.seq.load() | 1, memory_order_release);
+            atomic_thread_fence(memory_order_release);
+            copy.adults = adults;
+            copy.children = children;
+            copy.visits = current.visits + 1;
+            memcpy(copy.purposeCounts, current.purposeCounts, sizeof(copy.purposeCounts));
+            static const char* purposes[4] = {"family", "couple", "friends", "solo"};
+            for (int i = 0; i < 4; i++) {
+                if (tripPurpose == purposes[i]) copy.purposeCounts[i]++;
+            }
+            copy.nameOffset = current.nameOffset;
+            copy.nameLength = current.nameLength;
+            copy.emailOffset = current.emailOffset;
+            copy.emailLength = current.emailLength;
+            if ((isNew || name != storedName) && appendString(name, copy.nameOffset)) copy.nameLength = name.size();
+            if ((isNew || email != storedEmail) && appendString(email, copy.emailOffset)) copy.emailLength = email.size();
+            copy.seq.store(copy.seq.load() + 1, memory_order_release);
+            flush(&copy, sizeof(copy));
+
+            // Publish: flip the active copy (or claim the empty slot), then flush
+            slot->active.store(target, memory_order_release);
+            if (isNew) {
+                slot->key.store(key, memory_order_release);
+                h->count++;
+            }
+            flush(slot, sizeof(Slot));
+            flush(h, sizeof(StoreHeader));
+            ok = true;
+            break;
+        }
+        flock(fd, LOCK_UN);
+        return ok;
+    }
+};
+
 // --------------------- CustomerDetails ---------------------
 class CustomerDetails {
 public:
@@ -65,34 +492,44 @@ public:
     int adults, children;
     string tripPurpose; // family, couple, friends, solo
     
-    bool inputDetails() {
+    // With a store, returning customers get their saved details offered as
+    // defaults: pressing Enter at a prompt keeps the value shown in brackets.
+    bool inputDetails(const CustomerStore* store = nullptr) {
         cout << "\nEnter customer details (type 'x' anytime to restart):\n";
+        CustomerProfile saved;
+        bool returning = false;
 
         cout << "Name of the customer: ";
-        getline(cin, name);
-        if (toLower(name) == "x") return false;
+        if (!getline(cin, name) || toLower(name) == "x") return false;
 
         while (true) {
             cout << "Enter your 10-digit number: ";
-            getline(cin, number);
-            if (toLower(number) == "x") return false;
+            if (!getline(cin, number) || toLower(number) == "x") return false;
             if (isValidNumber(number)) break;
             else cout << "Invalid number. Please enter exactly 10 digits.\n";
         }
 
+        if (store != nullptr && store->lookup(number, saved)) {
+            returning = true;
+            if (name.empty()) name = saved.name;
+            cout << "Welcome back, " << saved.name << "! (" << saved.visits << " previous visit"
+                 << (saved.visits == 1 ? "" : "s") << ")\n";
+        }
+
         while (true) {
-            cout << "Enter your email: ";
-            getline(cin, email);
-            if (toLower(email) == "x") return false;
+            cout << "Enter your email" << (returning ? " [" + saved.email + "]" : "") << ": ";
+            if (!getline(cin, email) || toLower(email) == "x") return false;
+            if (returning && email.empty()) email = saved.email;
             if (isValidEmail(email)) break;
             else cout << "Invalid email format. Please try again.\n";
         }
 
         while (true) {
-            cout << "Number of adults traveling: ";
+            cout << "Number of adults traveling"
+                 << (returning ? " [" + to_string(saved.lastAdults) + "]" : "") << ": ";
             string input;
-            getline(cin, input);
-            if (toLower(input) == "x") return false;
+            if (!getline(cin, input) || toLower(input) == "x") return false;
+            if (returning && input.empty()) input = to_string(saved.lastAdults);
             try {
                 adults = stoi(input);
                 if (adults <= 0) throw invalid_argument("");
@@ -103,10 +540,11 @@ public:
         }
 
         while (true) {
-            cout << "Number of children traveling: ";
+            cout << "Number of children traveling"
+                 << (returning ? " [" + to_string(saved.lastChildren) + "]" : "") << ": ";
             string input;
-            getline(cin, input);
-            if (toLower(input) == "x") return false;
+            if (!getline(cin, input) || toLower(input) == "x") return false;
+            if (returning && input.empty()) input = to_string(saved.lastChildren);
             try {
                 children = stoi(input);
                 if (children < 0) throw invalid_argument("");
@@ -117,8 +555,10 @@ public:
         }
 
         while (true) {
-            cout << "Trip purpose (family/couple/friends/solo): ";
-            getline(cin, tripPurpose);
+            cout << "Trip purpose (family/couple/friends/solo)"
+                 << (returning ? " [" + saved.favouritePurpose() + "]" : "") << ": ";
+            if (!getline(cin, tripPurpose)) return false;
+            if (returning && tripPurpose.empty()) tripPurpose = saved.favouritePurpose();
             tripPurpose = toLower(tripPurpose);
             if (tripPurpose == "x") return false;
             if (tripPurpose == "family" || tripPurpose == "couple" || 
@@ -140,7 +580,199 @@ public:
     }
 };
 
+// --------------------- Dates & PriceCalendar ---------------------
+// Dates are handled as day numbers (days since 1970-01-01)
+int daysFromCivil(int y, int m, int d) {
+    y -= m <= 2;
+    int era = (y >= 0 ? y : y - 399) / 400;
+    int yoe = y - era * 400;
+    int doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+    int doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + doe - 719468;
+}
+
+void civilFromDays(int z, int& y, int& m, int& d) {
+    z += 719468;
+    int era = (z >= 0 ? z : z - 146096) / 146097;
+    int doe = z - era * 146097;
+    int yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    int doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    int mp = (5 * doy + 2) / 153;
+    d = doy - (153 * mp + 2) / 5 + 1;
+    m = mp + (mp < 10 ? 3 : -9);
+    y = yoe + era * 400 + (m <= 2);
+}
+
+string formatDate(int day) {
+    int y, m, d;
+    civilFromDays(day, y, m, d);
+    ostringstream out;
+    out << y << "-" << setw(2) << setfill('0') << m << "-" << setw(2) << d;
+    return out.str();
+}
+
+// Parses YYYY-MM-DD, returns -1 if the text is not a valid date
+int parseDate(const string& text) {
+    int y, m, d;
+    char dash1, dash2;
+    istringstream in(text);
+    if (!(in >> y >> dash1 >> m >> dash2 >> d) || dash1 != '-' || dash2 != '-') return -1;
+    if (m < 1 || m > 12 || d < 1 || d > 31) return -1;
+    int day = daysFromCivil(y, m, d);
+    int cy, cm, cd;
+    civilFromDays(day, cy, cm, cd);
+    return (cm == m && cd == d) ? day : -1;
+}
+
+// WANDERPLAN_TODAY (YYYY-MM-DD) pins the date, so a replayed session prices
+// the same days as when it was recorded
+int todayDayNumber() {
+    const char* pinned = getenv("WANDERPLAN_TODAY");
+    if (pinned != NULL && parseDate(pinned) >= 0) return parseDate(pinned);
+    time_t now = time(nullptr);
+    tm local = *localtime(&now);
+    return daysFromCivil(local.tm_year + 1900, local.tm_mon + 1, local.tm_mday);
+}
+
+// Price multiplier over time, stored as run-length segments (start day ->
+// multiplier, each run lasting until the next start) plus a repeating
+// per-weekday factor. A year of seasonal prices is a handful of segments.
+class PriceCalendar {
+private:
+    vector<int> segmentStart;        // Sorted; segmentStart[0] covers all earlier days
+    vector<double> segmentMultiplier;
+    double weekdayMultiplier[7];     // 0 = Monday
+
+    double seasonalOn(int day) const {
+        size_t i = upper_bound(segmentStart.begin(), segmentStart.end(), day) - segmentStart.begin();
+        return i == 0 ? 1.0 : segmentMultiplier[i - 1];
+    }
+
+public:
+    PriceCalendar() {
+        for (int i = 0; i < 7; i++) weekdayMultiplier[i] = 1.0;
+    }
+
+    static int weekday(int day) {
+        return ((day % 7) + 7 + 3) % 7; // 1970-01-01 was a Thursday
+    }
+
+    // Sets the seasonal multiplier for days in [fromDay, toDay)
+    void setRange(int fromDay, int toDay, double multiplier) {
+        if (fromDay >= toDay) return;
+        double after = seasonalOn(toDay);
+        vector<int> starts;
+        vector<double> values;
+        for (size_t i = 0; i < segmentStart.size(); i++) {
+            if (segmentStart[i] < fromDay) {
+                starts.push_back(segmentStart[i]);
+                values.push_back(segmentMultiplier[i]);
+            }
+        }
+        starts.push_back(fromDay);
+        values.push_back(multiplier);
+        starts.push_back(toDay);
+        values.push_back(after);
+        for (size_t i = 0; i < segmentStart.size(); i++) {
+            if (segmentStart[i] > toDay) {
+                starts.push_back(segmentStart[i]);
+                values.push_back(segmentMultiplier[i]);
+            }
+        }
+        // Merge runs that ended up with the same multiplier
+        segmentStart.clear();
+        segmentMultiplier.clear();
+        double previous = 1.0;
+        for (size_t i = 0; i < starts.size(); i++) {
+            if (values[i] == previous) continue;
+            segmentStart.push_back(starts[i]);
+            segmentMultiplier.push_back(values[i]);
+            previous = values[i];
+        }
+    }
+
+    void setWeekdayMultiplier(int day, double multiplier) {
+        weekdayMultiplier[day] = multiplier;
+    }
+
+    double multiplierOn(int day) const {
+        return seasonalOn(day) * weekdayMultiplier[weekday(day)];
+    }
+
+    // Builds a calendar from a free-text season such as "October-March":
+    // months inside the season get peakMultiplier, the rest offMultiplier.
+    // Text without two recognisable month names gives a flat calendar.
+    static PriceCalendar fromSeason(const string& season, double peakMultiplier, double offMultiplier) {
+        static const char* monthNames[12] = {"jan", "feb", "mar", "apr", "may", "jun",
+                                             "jul", "aug", "sep", "oct", "nov", "dec"};
+        PriceCalendar calendar;
+        vector<int> months;
+        string lower = toLower(season);
+        size_t pos = 0;
+        while (pos < lower.length() && months.size() < 2) {
+            size_t end = lower.find('-', pos);
+            if (end == string::npos) end = lower.length();
+            string word = lower.substr(pos, end - pos);
+            word.erase(0, word.find_first_not_of(' '));
+            for (int m = 0; m < 12; m++) {
+                if (word.compare(0, 3, monthNames[m]) == 0) months.push_back(m + 1);
+            }
+            pos = end + 1;
+        }
+        if (months.size() < 2) return calendar;
+
+        int y, m, d;
+        civilFromDays(todayDayNumber(), y, m, d);
+        for (int year = y - 1; year <= y + 2; year++) {
+            for (int month = 1; month <= 12; month++) {
+                bool peak = (months[0] <= months[1]) ? (month >= months[0] && month <= months[1])
+                                                     : (month >= months[0] || month <= months[1]);
+                int start = daysFromCivil(year, month, 1);
+                int end = (month == 12) ? daysFromCivil(year + 1, 1, 1) : daysFromCivil(year, month + 1, 1);
+                calendar.setRange(start, end, peak ? peakMultiplier : offMultiplier);
+            }
+        }
+        return calendar;
+    }
+};
+
+// Prefix sums over a run of daily prices, for O(1) range totals
+class PriceIndex {
+private:
+    int startDay;
+    vector<double> prefix;
+
+public:
+    PriceIndex(int startDay, const vector<double>& dailyPrices) : startDay(startDay) {
+        prefix.assign(dailyPrices.size() + 1, 0.0);
+        for (size_t i = 0; i < dailyPrices.size(); i++) prefix[i + 1] = prefix[i] + dailyPrices[i];
+    }
+
+    // Total over days [fromDay, toDay)
+    double rangeSum(int fromDay, int toDay) const {
+        int from = max(0, fromDay - startDay);
+        int to = min((int)prefix.size() - 1, toDay - startDay);
+        return (to > from) ? prefix[to] - prefix[from] : 0.0;
+    }
+};
+
 // --------------------- Destination & PreferenceTree ---------------------
+struct AttractionInfo {
+    string name;
+    double visitHours; // Typical time spent at the attraction
+    double x, y;       // Position in km relative to the destination's centre
+};
+
+// Stable FNV-1a hash, used wherever a name needs a reproducible number
+unsigned int stableHash(const string& s) {
+    unsigned int h = 2166136261u;
+    for (char c : s) {
+        h ^= (unsigned char)c;
+        h *= 16777619u;
+    }
+    return h;
+}
+
 class Destination {
 public:
     string name, type, currency;
@@ -153,6 +785,9 @@ public:
     string weather;
     string visaInfo;
     string bestSeason;
+    vector<AttractionInfo> attractionDetails; // Surveyed visit times and locations; empty if unknown
+    PriceCalendar priceCalendar; // Seasonal multiplier on minbudget/maxbudget
+    int id; // position in PreferenceTree's insertion order
     Destination *left, *right;
 
     Destination(string n, string t, string curr, double minb, double maxb, 
@@ -170,15 +805,248 @@ public:
         weather = wthr;
         visaInfo = visa;
         bestSeason = season;
+        priceCalendar = PriceCalendar::fromSeason(bestSeason, 1.15, 0.9);
+        id = -1;
         left = right = NULL;
     }
 };
 
+// --------------------- KeywordIndex ---------------------
+// Inverted index over attractions, foods and itinerary text. Each term maps to
+// a posting list of (destination id, weight) pairs stored as varint-encoded id
+// gaps, so lists stay small and are decoded in id order for merging.
+struct KeywordMatch {
+    int id;           // Destination id
+    int score;        // Sum of field weights over matched terms
+    int termsMatched; // Number of distinct query terms found
+};
+
+class KeywordIndex {
+private:
+    struct PostingList {
+        vector<unsigned char> bytes;
+        int lastId;
+        int count;
+    };
+
+    map<string, PostingList> postings;
+
+    static void writeVarint(vector<unsigned char>& out, unsigned int value) {
+        while (value >= 0x80) {
+            out.push_back((unsigned char)(value | 0x80));
+            value >>= 7;
+        }
+        out.push_back((unsigned char)value);
+    }
+
+    static unsigned int readVarint(const vector<unsigned char>& in, size_t& pos) {
+        unsigned int value = 0;
+        int shift = 0;
+        while (pos < in.size()) {
+            unsigned char b = in[pos++];
+            value |= (unsigned int)(b & 0x7F) << shift;
+            if (!(b & 0x80)) break;
+            shift += 7;
+        }
+        return value;
+    }
+
+    // Decodes a posting list into (id, weight) pairs, sorted by id
+    static vector<pair<int, int>> decode(const PostingList& list) {
+        vector<pair<int, int>> result;
+        result.reserve(list.count);
+        size_t pos = 0;
+        int id = 0;
+        while (pos < list.bytes.size()) {
+            id += (int)readVarint(list.bytes, pos);
+            int weight = list.bytes[pos++];
+            result.push_back({id, weight});
+        }
+        return result;
+    }
+
+    static bool isStopWord(const string& word) {
+        return word == "and" || word == "or" || word == "the" || word == "of" ||
+               word == "in" || word == "to" || word == "a" || word == "day" ||
+               word == "see" || word == "under" || word == "where" || word == "can" ||
+               word == "i" || word == "with";
+    }
+
+    // Very small plural folding so "temples" finds "Temple" and "beaches" finds "Beach"
+    static string normalize(const string& word) {
+        size_t n = word.length();
+        if (n > 4 && word.compare(n - 3, 3, "ies") == 0) return word.substr(0, n - 3) + "y";
+        if (n > 4 && (word.compare(n - 4, 4, "ches") == 0 || word.compare(n - 4, 4, "shes") == 0 ||
+                      word.compare(n - 4, 4, "sses") == 0 || word.compare(n - 3, 3, "xes") == 0))
+            return word.substr(0, n - 2);
+        if (n > 3 && word[n - 1] == 's' && word[n - 2] != 's') return word.substr(0, n - 1);
+        return word;
+    }
+
+public:
+    static vector<string> tokenize(const string& text) {
+        vector<string> tokens;
+        string current;
+        for (size_t i = 0; i <= text.length(); i++) {
+            char c = (i < text.length()) ? text[i] : ' ';
+            if (isalnum((unsigned char)c)) {
+                current += (char)tolower((unsigned char)c);
+            } else if (!current.empty()) {
+                if (!isStopWord(current) && !(current.length() == 1 && isdigit((unsigned char)current[0]))) {
+                    tokens.push_back(normalize(current));
+                }
+                current.clear();
+            }
+        }
+        return tokens;
+    }
+
+    // Documents must be added in increasing id order
+    void addDocument(int id, const vector<string>& attractions, const vector<string>& foods,
+                     const vector<string> itineraries[3]) {
+        // Attractions weigh most, then itinerary mentions, then foods
+        map<string, int> weights;
+        for (auto& attr : attractions)
+            for (auto& token : tokenize(attr)) weights[token] += 3;
+        for (auto& food : foods)
+            for (auto& token : tokenize(food)) weights[token] += 1;
+        for (int i = 0; i < 3; i++)
+            for (auto& day : itineraries[i])
+                for (auto& token : tokenize(day)) weights[token] += 2;
+
+        for (auto& entry : weights) {
+            auto it = postings.find(entry.first);
+            if (it == postings.end()) {
+                it = postings.insert({entry.first, PostingList{{}, 0, 0}}).first;
+            }
+            PostingList& list = it->second;
+            writeVarint(list.bytes, (unsigned int)(id - list.lastId));
+            list.bytes.push_back((unsigned char)min(entry.second, 255));
+            list.lastId = id;
+            list.count++;
+        }
+    }
+
+    // matchAll = true intersects the posting lists (AND), false unions them (OR).
+    // Results are ordered by terms matched, then score, then id.
+    vector<KeywordMatch> search(const string& query, bool matchAll) const {
+        vector<string> terms = tokenize(query);
+        sort(terms.begin(), terms.end());
+        terms.erase(unique(terms.begin(), terms.end()), terms.end());
+
+        vector<vector<pair<int, int>>> lists;
+        for (auto& term : terms) {
+            auto it = postings.find(term);
+            if (it == postings.end()) {
+                if (matchAll) return {};
+                continue;
+            }
+            lists.push_back(decode(it->second));
+        }
+        if (lists.empty()) return {};
+
+        vector<KeywordMatch> matches;
+        if (matchAll) {
+            // Intersect starting from the shortest list
+            sort(lists.begin(), lists.end(),
+                 [](const vector<pair<int, int>>& a, const vector<pair<int, int>>& b) {
+                     return a.size() < b.size();
+                 });
+            for (auto& p : lists[0]) matches.push_back({p.first, p.second, 1});
+            for (size_t l = 1; l < lists.size() && !matches.empty(); l++) {
+                vector<KeywordMatch> next;
+                size_t i = 0, j = 0;
+                while (i < matches.size() && j < lists[l].size()) {
+                    if (matches[i].id < lists[l][j].first) i++;
+                    else if (matches[i].id > lists[l][j].first) j++;
+                    else {
+                        next.push_back({matches[i].id, matches[i].score + lists[l][j].second,
+                                        matches[i].termsMatched + 1});
+                        i++; j++;
+                    }
+                }
+                matches.swap(next);
+            }
+        } else {
+            for (auto& list : lists) {
+                vector<KeywordMatch> merged;
+                size_t i = 0, j = 0;
+                while (i < matches.size() || j < list.size()) {
+                    if (j == list.size() || (i < matches.size() && matches[i].id < list[j].first)) {
+                        merged.push_back(matches[i++]);
+                    } else if (i == matches.size() || list[j].first < matches[i].id) {
+                        merged.push_back({list[j].first, list[j].second, 1});
+                        j++;
+                    } else {
+                        merged.push_back({matches[i].id, matches[i].score + list[j].second,
+                                          matches[i].termsMatched + 1});
+                        i++; j++;
+                    }
+                }
+                matches.swap(merged);
+            }
+        }
+
+        sort(matches.begin(), matches.end(), [](const KeywordMatch& a, const KeywordMatch& b) {
+            if (a.termsMatched != b.termsMatched) return a.termsMatched > b.termsMatched;
+            if (a.score != b.score) return a.score > b.score;
+            return a.id < b.id;
+        });
+        return matches;
+    }
+};
+
+// Query types for PreferenceTree. Queries are const and write into
+// caller-owned buffers, so one catalog can serve many threads at once as long
+// as nothing is added to it meanwhile.
+struct BudgetBand {
+    string label;
+    double minRange, maxRange;
+};
+
+struct BudgetQuery {
+    string tripType;      // "National" or "International"
+    double minRange, maxRange;
+    string tripPurpose;
+    int adults, children;
+    int travelDay;        // Day number for seasonal prices, -1 for year-round
+};
+
+struct KeywordQuery {
+    string text;
+    bool matchAll;        // AND when true, OR when false
+    string tripType;      // Empty matches both trip types
+    double maxBudget;     // Cap on the party's minimum cost, <= 0 for no limit
+    string tripPurpose;
+    int adults, children;
+    int travelDay;        // Day number for seasonal prices, -1 for year-round
+
+    // A query from text as typed: any standalone "or" (in any case) switches
+    // the whole query to OR matching, otherwise every term must match. The
+    // filters start open (any trip type, purpose and budget, one adult);
+    // callers set the ones they need.
+    static KeywordQuery parse(const string& text) {
+        vector<string> words;
+        string word;
+        for (char c : toLower(text) + " ") {
+            if (isalnum((unsigned char)c)) word += c;
+            else if (!word.empty()) { words.push_back(word); word.clear(); }
+        }
+        bool matchAll = find(words.begin(), words.end(), "or") == words.end();
+        return {text, matchAll, "", 0, "", 1, 0, -1};
+    }
+};
+
+// How destinations are split across catalog shards
+enum ShardKey { SHARD_BY_HASH, SHARD_BY_TYPE };
+
 class PreferenceTree {
 private:
     Destination* root;
-    vector<Destination*> available;
     vector<Destination*> allDestinations;
+    KeywordIndex keywordIndex;
+    int shardIndex, shardCount; // This tree keeps only destinations of its shard
+    ShardKey shardKey;
 
     Destination* insert(Destination* node, string name, string type, string currency, 
                        double minb, double maxb, vector<string> attr, vector<string> fd,
@@ -188,7 +1056,9 @@ private:
             Destination* newDest = new Destination(name, type, currency, minb, maxb, attr, fd, 
                                                  itin1, itin2, itin3, famFriendly, coupFriendly,
                                                  weather, visa, season);
+            newDest->id = allDestinations.size();
             allDestinations.push_back(newDest);
+            keywordIndex.addDocument(newDest->id, attr, fd, newDest->itineraryOptions);
             return newDest;
         }
         if (type == "National")
@@ -200,79 +1070,172 @@ private:
         return node;
     }
 
-    void collectDestinationsByBudgetRange(Destination* node, const string& selectedType, 
-                                        double minRange, double maxRange,
-                                        const string& tripPurpose, int adults, int children) {
+    void collectDestinationsByBudgetRange(const Destination* node, const BudgetQuery& query,
+                                          vector<const Destination*>& out) const {
         if (node == NULL) return;
         
         // Calculate total budget for all travelers (children at 70% cost)
-        double minTotal = node->minbudget * adults + node->minbudget * children * 0.7;
-        double maxTotal = node->maxbudget * adults + node->maxbudget * children * 0.7;
+        double minTotal, maxTotal;
+        partyCostRange(node, query.adults, query.children, query.travelDay, minTotal, maxTotal);
         
-        if (node->type == selectedType && 
-            ((minTotal >= minRange && minTotal <= maxRange) || 
-             (maxTotal >= minRange && maxTotal <= maxRange))) {
+        if (node->type == query.tripType && 
+            ((minTotal >= query.minRange && minTotal <= query.maxRange) || 
+             (maxTotal >= query.minRange && maxTotal <= query.maxRange))) {
             // Check if destination matches trip purpose
-            if ((tripPurpose == "family" && node->familyFriendly) ||
-                (tripPurpose == "couple" && node->coupleFriendly) ||
-                (tripPurpose == "friends" || tripPurpose == "solo")) {
-                available.push_back(node);
+            if (matchesTripPurpose(node, query.tripPurpose)) {
+                out.push_back(node);
             }
         }
         
-        collectDestinationsByBudgetRange(node->left, selectedType, minRange, maxRange, 
-                                       tripPurpose, adults, children);
-        collectDestinationsByBudgetRange(node->right, selectedType, minRange, maxRange, 
-                                       tripPurpose, adults, children);
+        collectDestinationsByBudgetRange(node->left, query, out);
+        collectDestinationsByBudgetRange(node->right, query, out);
+    }
+
+    Destination* findByName(const string& name) {
+        for (auto dest : allDestinations) {
+            if (toLower(dest->name) == toLower(name)) {
+                return dest;
+            }
+        }
+        return NULL;
+    }
+
+    // An empty purpose matches every destination
+    static bool matchesTripPurpose(const Destination* node, const string& tripPurpose) {
+        return tripPurpose.empty() ||
+               (tripPurpose == "family" && node->familyFriendly) ||
+               (tripPurpose == "couple" && node->coupleFriendly) ||
+               (tripPurpose == "friends" || tripPurpose == "solo");
     }
 
 public:
-    PreferenceTree() { root = NULL; }
+    PreferenceTree() {
+        root = NULL;
+        shardIndex = 0;
+        shardCount = 1;
+        shardKey = SHARD_BY_HASH;
+    }
+
+    static int shardOf(const string& name, const string& type, int count, ShardKey key) {
+        if (key == SHARD_BY_TYPE) return (type == "National" ? 0 : 1) % count;
+        return stableHash(toLower(name)) % count;
+    }
+
+    // Must be set before destinations are added
+    void setShard(int index, int count, ShardKey key) {
+        shardIndex = index;
+        shardCount = max(1, count);
+        shardKey = key;
+    }
+
+    // Party cost range (children at 70%), seasonally adjusted when travelDay >= 0
+    static void partyCostRange(const Destination* dest, int adults, int children, int travelDay,
+                               double& minTotal, double& maxTotal) {
+        double season = (travelDay >= 0) ? dest->priceCalendar.multiplierOn(travelDay) : 1.0;
+        minTotal = (dest->minbudget * adults + dest->minbudget * children * 0.7) * season;
+        maxTotal = (dest->maxbudget * adults + dest->maxbudget * children * 0.7) * season;
+    }
 
     void addDestination(string name, string type, string currency, double minbudget, double maxbudget,
                        vector<string> attr, vector<string> fd,
                        vector<string> itin1, vector<string> itin2, vector<string> itin3,
                        bool famFriendly, bool coupFriendly, string weather, string visa, string season) {
+        if (shardCount > 1 && shardOf(name, type, shardCount, shardKey) != shardIndex) return;
         root = insert(root, name, type, currency, minbudget, maxbudget, attr, fd, 
                      itin1, itin2, itin3, famFriendly, coupFriendly, weather, visa, season);
     }
 
-    void showBudgetRanges(const string& tripType, const string& tripPurpose, int adults, int children) {
-        cout << "\n--- Available Budget Ranges for " << tripType << " Trips ---\n";
-        
-        // Define budget ranges with clear labels
-        vector<pair<string, pair<double, double>>> ranges;
+    static vector<BudgetBand> budgetBands(const string& tripType) {
         if (tripType == "National") {
-            cout << "1. Budget (15,000-30,000 INR)\n";
-            cout << "2. Mid-Range (30,000-50,000 INR)\n";
-            cout << "3. Premium (50,000-80,000 INR)\n";
-            ranges = {
-                {"Budget (15,000-30,000 INR)", {15000, 30000}},
-                {"Mid-Range (30,000-50,000 INR)", {30000, 50000}},
-                {"Premium (50,000-80,000 INR)", {50000, 80000}}
-            };
-        } else {
-            cout << "1. Budget (50,000-1,00,000 INR)\n";
-            cout << "2. Mid-Range (1,00,000-2,00,000 INR)\n";
-            cout << "3. Premium (2,00,000+ INR)\n";
-            ranges = {
-                {"Budget (50,000-1,00,000 INR)", {50000, 100000}},
-                {"Mid-Range (1,00,000-2,00,000 INR)", {100000, 200000}},
-                {"Premium (2,00,000+ INR)", {200000, 500000}}
+            return {
+                {"Budget (15,000-30,000 INR)", 15000, 30000},
+                {"Mid-Range (30,000-50,000 INR)", 30000, 50000},
+                {"Premium (50,000-80,000 INR)", 50000, 80000}
             };
         }
+        return {
+            {"Budget (50,000-1,00,000 INR)", 50000, 100000},
+            {"Mid-Range (1,00,000-2,00,000 INR)", 100000, 200000},
+            {"Premium (2,00,000+ INR)", 200000, 500000}
+        };
+    }
+
+    // Destinations of query.tripType whose party cost overlaps the range,
+    // filtered by trip purpose. Replaces the contents of `out`.
+    void findByBudgetRange(const BudgetQuery& query, vector<const Destination*>& out) const {
+        out.clear();
+        collectDestinationsByBudgetRange(root, query, out);
+    }
+
+    // Keyword search over attractions, foods and itineraries, combined with the
+    // trip-purpose filter and the optional budget cap. Ranked by terms matched,
+    // then score, then destination name, so a sharded catalog merges to the same
+    // order. Replaces the contents of `out`.
+    void searchByKeywords(const KeywordQuery& query, vector<KeywordMatch>& out) const {
+        out.clear();
+        for (auto& match : keywordIndex.search(query.text, query.matchAll)) {
+            const Destination* dest = allDestinations[match.id];
+            double minTotal, maxTotal;
+            partyCostRange(dest, query.adults, query.children, query.travelDay, minTotal, maxTotal);
+            if (!query.tripType.empty() && dest->type != query.tripType) continue;
+            if (query.maxBudget > 0 && minTotal > query.maxBudget) continue;
+            if (!matchesTripPurpose(dest, query.tripPurpose)) continue;
+            out.push_back(match);
+        }
+        sort(out.begin(), out.end(), [this](const KeywordMatch& a, const KeywordMatch& b) {
+            if (a.termsMatched != b.termsMatched) return a.termsMatched > b.termsMatched;
+            if (a.score != b.score) return a.score > b.score;
+            return allDestinations[a.id]->name < allDestinations[b.id]->name;
+        });
+    }
+
+    const Destination* getDestinationById(int id) const {
+        if (id < 0 || id >= (int)allDestinations.size()) return NULL;
+        return allDestinations[id];
+    }
+
+    const Destination* getDestinationByName(const string& name) const {
+        for (auto dest : allDestinations) {
+            if (toLower(dest->name) == toLower(name)) {
+                return dest;
+            }
+        }
+        return NULL;
+    }
+
+    size_t size() const { return allDestinations.size(); }
+
+    // Attaches surveyed visit times and locations; only destinations with this
+    // data are offered generated itineraries
+    bool setAttractionDetails(const string& name, const vector<AttractionInfo>& details) {
+        Destination* dest = findByName(name);
+        if (dest == NULL) return false;
+        dest->attractionDetails = details;
+        return true;
+    }
+
+    // ---- Interactive prompts built on the queries above ----
+
+    void showBudgetRanges(const string& tripType, const string& tripPurpose, int adults, int children,
+                          int travelDay = -1) const {
+        cout << "\n--- Available Budget Ranges for " << tripType << " Trips ---\n";
+        
+        vector<BudgetBand> bands = budgetBands(tripType);
+        for (size_t i = 0; i < bands.size(); i++) {
+            cout << (i+1) << ". " << bands[i].label << "\n";
+        }
         
         // Show destinations for each range
-        for (size_t i = 0; i < ranges.size(); i++) {
-            available.clear();
-            collectDestinationsByBudgetRange(root, tripType, ranges[i].second.first, ranges[i].second.second, 
-                                           tripPurpose, adults, children);
+        vector<const Destination*> available;
+        for (size_t i = 0; i < bands.size(); i++) {
+            findByBudgetRange({tripType, bands[i].minRange, bands[i].maxRange, tripPurpose,
+                               adults, children, travelDay}, available);
             
             if (!available.empty()) {
-                cout << "\n" << (i+1) << ". " << ranges[i].first << ":\n";
+                cout << "\n" << (i+1) << ". " << bands[i].label << ":\n";
                 for (size_t j = 0; j < available.size(); j++) {
-                    double minTotal = available[j]->minbudget * adults + available[j]->minbudget * children * 0.7;
-                    double maxTotal = available[j]->maxbudget * adults + available[j]->maxbudget * children * 0.7;
+                    double minTotal, maxTotal;
+                    partyCostRange(available[j], adults, children, travelDay, minTotal, maxTotal);
                     
                     cout << "   " << (j+1) << ") " << available[j]->name << " (" 
                          << fixed << setprecision(0) << minTotal << " - " << maxTotal << " INR)\n";
@@ -281,36 +1244,23 @@ public:
         }
     }
 
-    Destination* selectDestinationFromRange(const string& tripType, const string& tripPurpose, 
-                                          int adults, int children, int rangeChoice) {
-        // Define budget ranges based on choice
-        pair<double, double> range;
-        if (tripType == "National") {
-            switch(rangeChoice) {
-                case 1: range = {15000, 30000}; break;
-                case 2: range = {30000, 50000}; break;
-                case 3: range = {50000, 80000}; break;
-                default: return nullptr;
-            }
-        } else {
-            switch(rangeChoice) {
-                case 1: range = {50000, 100000}; break;
-                case 2: range = {100000, 200000}; break;
-                case 3: range = {200000, 500000}; break;
-                default: return nullptr;
-            }
-        }
+    const Destination* selectDestinationFromRange(const string& tripType, const string& tripPurpose, 
+                                                  int adults, int children, int rangeChoice,
+                                                  int travelDay = -1) const {
+        vector<BudgetBand> bands = budgetBands(tripType);
+        if (rangeChoice < 1 || rangeChoice > (int)bands.size()) return nullptr;
+        const BudgetBand& band = bands[rangeChoice - 1];
         
-        available.clear();
-        collectDestinationsByBudgetRange(root, tripType, range.first, range.second, 
-                                       tripPurpose, adults, children);
+        vector<const Destination*> available;
+        findByBudgetRange({tripType, band.minRange, band.maxRange, tripPurpose, adults, children, travelDay},
+                          available);
         
         if (available.empty()) {
             return nullptr;
         }
         
         cout << "\nAvailable destinations in your selected range:\n";
-        for (int i = 0; i < available.size(); i++) {
+        for (size_t i = 0; i < available.size(); i++) {
             cout << (i+1) << ". " << available[i]->name << "\n";
         }
         
@@ -320,7 +1270,7 @@ public:
         
         try {
             int selected = stoi(choice) - 1;
-            if (selected >= 0 && selected < available.size()) {
+            if (selected >= 0 && selected < (int)available.size()) {
                 return available[selected];
             }
         } catch (...) {
@@ -330,21 +1280,65 @@ public:
         return nullptr;
     }
 
-    Destination* getDestinationByName(const string& name) {
-        for (auto dest : allDestinations) {
-            if (toLower(dest->name) == toLower(name)) {
-                return dest;
-            }
-        }
-        return NULL;
+    const Destination* selectDestinationByKeywords(const string& tripPurpose, int adults, int children,
+                                                   int travelDay = -1) const {
+        cout << "\nEnter keywords (e.g. temple beach, or 'temple or beach'): ";
+        string text;
+        getline(cin, text);
+        KeywordQuery query = KeywordQuery::parse(text);
+        query.tripPurpose = tripPurpose;
+        query.adults = adults;
+        query.children = children;
+        query.travelDay = travelDay;
+
+        cout << "Maximum total budget in INR (press Enter for no limit): ";
+        string budgetInput;
+        getline(cin, budgetInput);
+        try {
+            if (!budgetInput.empty()) query.maxBudget = stod(budgetInput);
+        } catch (...) {
+            cout << "Invalid budget, searching without a limit.\n";
+        }
+
+        vector<KeywordMatch> matches;
+        searchByKeywords(query, matches);
+        if (matches.empty()) {
+            cout << "\nNo destinations match your keywords.\n";
+            return nullptr;
+        }
+
+        cout << "\nMatching destinations:\n";
+        for (size_t i = 0; i < matches.size(); i++) {
+            const Destination* dest = allDestinations[matches[i].id];
+            double minTotal, maxTotal;
+            partyCostRange(dest, adults, children, travelDay, minTotal, maxTotal);
+            cout << (i+1) << ". " << dest->name << " [" << dest->type << "] ("
+                 << fixed << setprecision(0) << minTotal << " - " << maxTotal
+                 << " INR, match score " << matches[i].score << ")\n";
+        }
+
+        cout << "Select a destination (1-" << matches.size() << "): ";
+        string choice;
+        getline(cin, choice);
+
+        try {
+            int selected = stoi(choice) - 1;
+            if (selected >= 0 && selected < (int)matches.size()) {
+                return allDestinations[matches[selected].id];
+            }
+        } catch (...) {
+            return nullptr;
+        }
+
+        return nullptr;
     }
 
-    void showDestinationDetails(Destination* dest, int adults, int children) {
+    void showDestinationDetails(const Destination* dest, int adults, int children, int travelDay = -1) const {
         cout << "\n--- " << dest->name << " Destination Details ---\n";
         
         // Calculate total cost range
-        double minTotal = dest->minbudget * adults + dest->minbudget * children * 0.7;
-        double maxTotal = dest->maxbudget * adults + dest->maxbudget * children * 0.7;
+        double minTotal, maxTotal;
+        partyCostRange(dest, adults, children, travelDay, minTotal, maxTotal);
         double avgForeignCost = convertCurrency((minTotal + maxTotal)/2, "INR", dest->currency);
         
         cout << "\nEstimated Total Cost: " << fixed << setprecision(2) 
@@ -381,6 +1375,7 @@ public:
 class Transport {
 private:
     map<string, vector<pair<string, double>>> transportOptions;
+    map<string, PriceCalendar> fareCalendars; // Seasonal fare multipliers per destination
     
 public:
     Transport() {
@@ -423,20 +1418,48 @@ public:
         transportOptions["australia"] = {{"Flight", 60000}};
     }
     
-    void showTransportOptions(const string& destination, int adults, int children) {
+    vector<pair<string, double>> getOptions(const string& destination) const {
+        auto it = transportOptions.find(toLower(destination));
+        if (it == transportOptions.end()) return {};
+        return it->second;
+    }
+
+    void setFareCalendar(const string& destination, const PriceCalendar& calendar) {
+        fareCalendars[toLower(destination)] = calendar;
+    }
+
+    // Fares into each catalog destination: +30% during its best season, -10% outside it
+    void loadSeasonalFares(const PreferenceTree& catalog) {
+        for (size_t id = 0; id < catalog.size(); id++) {
+            const Destination* dest = catalog.getDestinationById(id);
+            if (transportOptions.count(toLower(dest->name))) {
+                setFareCalendar(dest->name, PriceCalendar::fromSeason(dest->bestSeason, 1.3, 0.9));
+            }
+        }
+    }
+
+    // Adult fare for a mode on a given day; the base fare when day is -1 or no calendar is set
+    double fareOn(const string& destination, double baseFare, int day) const {
+        auto it = fareCalendars.find(toLower(destination));
+        if (day < 0 || it == fareCalendars.end()) return baseFare;
+        return baseFare * it->second.multiplierOn(day);
+    }
+
+    void showTransportOptions(const string& destination, int adults, int children, int travelDay = -1) {
         string lowerDest = toLower(destination);
         if (transportOptions.find(lowerDest) == transportOptions.end()) {
             cout << "\nNo transport options available for " << destination << ".\n";
             return;
         }
         
-        cout << "\n--- Transport Options for " << destination << " ---\n";
+        cout << "\n--- Transport Options for " << destination
+             << (travelDay >= 0 ? " on " + formatDate(travelDay) : "") << " ---\n";
         cout << "Mode\t\tAdult Fare\tChild Fare\tTotal (" << adults << "A," << children << "C)\n";
         cout << "-------------------------------------------------\n";
         
         for (auto option : transportOptions[lowerDest]) {
             string mode = option.first;
-            double adultPrice = option.second;
+            double adultPrice = fareOn(lowerDest, option.second, travelDay);
             double childPrice = adultPrice * 0.7; // 30% discount for children
             double total = adultPrice * adults + childPrice * children;
             
@@ -455,7 +1478,7 @@ public:
             bool found = false;
             for (auto option : transportOptions[lowerDest]) {
                 if (toLower(option.first) == toLower(mode)) {
-                    double adultPrice = option.second;
+                    double adultPrice = fareOn(lowerDest, option.second, travelDay);
                     double childPrice = adultPrice * 0.7;
                     double total = adultPrice * adults + childPrice * children;
                     
@@ -496,6 +1519,7 @@ private:
     
     map<string, vector<Hotel>> hotels;
     map<string, vector<NearbyCity>> nearbyCities;
+    map<string, PriceCalendar> rateCalendars; // Seasonal/weekend rate multipliers per destination
     
 public:
     HotelAccommodation() {
@@ -560,31 +1584,73 @@ public:
         };
     }
     
-    void showHotelOptions(const string& destination, int adults, int children, int nights) {
+    // Lowest price per night at a destination, or -1 when it has no hotels
+    double cheapestNightlyRate(const string& destination) const {
+        auto it = hotels.find(toLower(destination));
+        if (it == hotels.end() || it->second.empty()) return -1;
+        double best = it->second[0].pricePerNight;
+        for (auto& hotel : it->second) best = min(best, hotel.pricePerNight);
+        return best;
+    }
+
+    void setRateCalendar(const string& destination, const PriceCalendar& calendar) {
+        rateCalendars[toLower(destination)] = calendar;
+    }
+
+    // Rates at each catalog destination: +25% during its best season, -15%
+    // outside it, and +15% on Friday and Saturday nights
+    void loadSeasonalRates(const PreferenceTree& catalog) {
+        for (size_t id = 0; id < catalog.size(); id++) {
+            const Destination* dest = catalog.getDestinationById(id);
+            if (!hotels.count(toLower(dest->name))) continue;
+            PriceCalendar rates = PriceCalendar::fromSeason(dest->bestSeason, 1.25, 0.85);
+            rates.setWeekdayMultiplier(4, 1.15);
+            rates.setWeekdayMultiplier(5, 1.15);
+            setRateCalendar(dest->name, rates);
+        }
+    }
+
+    // Rate for one night; the base rate when day is -1 or no calendar is set
+    double nightlyRateOn(const string& destination, double baseRate, int day) const {
+        auto it = rateCalendars.find(toLower(destination));
+        if (day < 0 || it == rateCalendars.end()) return baseRate;
+        return baseRate * it->second.multiplierOn(day);
+    }
+
+    // Room cost of a stay checking in on checkInDay (-1 for year-round rates):
+    // each night at its own rate, plus half a night per guest beyond two
+    double stayCost(const string& destination, double baseRate, int checkInDay, int nights, int guests) const {
+        double total = 0;
+        for (int i = 0; i < nights; i++) {
+            total += nightlyRateOn(destination, baseRate, checkInDay < 0 ? -1 : checkInDay + i);
+        }
+        return total + max(0, guests - 2) * nightlyRateOn(destination, baseRate, checkInDay) * 0.5;
+    }
+
+    void showHotelOptions(const string& destination, int adults, int children, int nights,
+                          int checkInDay = -1) {
         string lowerDest = toLower(destination);
         
         if (hotels.find(lowerDest) == hotels.end() || hotels[lowerDest].empty()) {
             cout << "\nNo hotel options available in " << destination << ".\n";
             if (nearbyCities.find(lowerDest) != nearbyCities.end()) {
-                showNearbyOptions(destination, adults, children, nights);
+                showNearbyOptions(destination, adults, children, nights, checkInDay);
             }
             return;
         }
         
-        cout << "\n--- Hotel Options in " << destination << " ---\n";
+        cout << "\n--- Hotel Options in " << destination
+             << (checkInDay >= 0 ? " from " + formatDate(checkInDay) : "") << " ---\n";
         cout << "Option\tHotel\t\tLocation\tPrice/Night\tTotal (" << nights << " nights)\n";
         cout << "----------------------------------------------------------------\n";
         
         int optionNum = 1;
         for (auto hotel : hotels[lowerDest]) {
-            double totalPrice = hotel.pricePerNight * nights;
-            // Children stay free in existing beds
-            if (adults + children > 2) {
-                totalPrice += (max(0, adults + children - 2) * hotel.pricePerNight * 0.5);
-            }
+            double nightly = nightlyRateOn(lowerDest, hotel.pricePerNight, checkInDay);
+            double totalPrice = stayCost(lowerDest, hotel.pricePerNight, checkInDay, nights, adults + children);
             
             cout << optionNum++ << "\t" << hotel.name << "\t" << hotel.location << "\t" 
-                 << hotel.pricePerNight << " INR\t" << totalPrice << " INR\n";
+                 << nightly << " INR\t" << totalPrice << " INR\n";
             
             cout << "   Amenities: ";
             if (hotel.familyFriendly) cout << "Family-friendly ";
@@ -605,10 +1671,8 @@ public:
                 int option = stoi(optionStr) - 1;
                 if (option >= 0 && option < hotels[lowerDest].size()) {
                     Hotel selected = hotels[lowerDest][option];
-                    double totalPrice = selected.pricePerNight * nights;
-                    if (adults + children > 2) {
-                        totalPrice += (max(0, adults + children - 2) * selected.pricePerNight * 0.5);
-                    }
+                    double totalPrice = stayCost(lowerDest, selected.pricePerNight, checkInDay, nights,
+                                                 adults + children);
                     
                     cout << "\nBooking confirmed at " << selected.name << "!\n";
                     cout << "Location: " << selected.location << "\n";
@@ -622,7 +1686,23 @@ public:
         }
     }
     
-    void showNearbyOptions(const string& destination, int adults, int children, int nights) {
+    // Looks up `to` among the nearby cities of `from`; fills mode -> adult fare
+    bool getNearbyFares(const string& from, const string& to, map<string, double>& fares,
+                        double& distance) const {
+        auto it = nearbyCities.find(toLower(from));
+        if (it == nearbyCities.end()) return false;
+        for (auto& city : it->second) {
+            if (toLower(city.name) == toLower(to)) {
+                fares = city.transportPrices;
+                distance = city.distance;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void showNearbyOptions(const string& destination, int adults, int children, int nights,
+                           int checkInDay = -1) {
         string lowerDest = toLower(destination);
         cout << "\nNo hotels available in " << destination << ", but here are nearby options:\n";
         
@@ -645,13 +1725,12 @@ public:
                 cout << "\nAvailable Hotels in " << city.name << ":\n";
                 int hotelNum = 1;
                 for (auto& hotel : hotels[toLower(city.name)]) {
-                    double totalPrice = hotel.pricePerNight * nights;
-                    if (adults + children > 2) {
-                        totalPrice += (max(0, adults + children - 2) * hotel.pricePerNight * 0.5);
-                    }
+                    double totalPrice = stayCost(city.name, hotel.pricePerNight, checkInDay, nights,
+                                                 adults + children);
                     
                     cout << hotelNum++ << ". " << hotel.name << " (" << hotel.area << ")\n"
-                         << "   " << hotel.pricePerNight << " INR/night, Total: " << totalPrice << " INR\n"
+                         << "   " << nightlyRateOn(city.name, hotel.pricePerNight, checkInDay)
+                         << " INR/night, Total: " << totalPrice << " INR\n"
                          << "   Amenities: ";
                     if (hotel.familyFriendly) cout << "Family-friendly ";
                     if (hotel.hasPool) cout << "Pool ";
@@ -663,192 +1742,2433 @@ public:
     }
 };
 
-// --------------------- Main Function ---------------------
-int main() {
-    cout << "====== SMART WANDERPLAN - COMPREHENSIVE TRAVEL PLANNER ======\n";
-    
-    while (true) {
-        CustomerDetails customer;
-        if (!customer.inputDetails()) {
-            cout << "Restarting input...\n";
-            continue;
+// --------------------- Seasonal Pricing ---------------------
+struct TravelWindow {
+    int startDay;
+    string transportMode;
+    double packageCost;   // Destination spend for the party
+    double transportCost;
+    double hotelCost;
+    double total;
+};
+
+// Cheapest start day for a stay of `nights` within [fromDay, fromDay + horizonDays).
+// Hotel nights are summed through a prefix-sum index so each candidate start
+// costs O(1) instead of re-pricing every night. Returns startDay = -1 if the
+// destination has no transport or hotel data.
+TravelWindow findCheapestWindow(const Destination* dest, const Transport& transport,
+                                const HotelAccommodation& hotels, int adults, int children,
+                                int nights, int fromDay, int horizonDays) {
+    TravelWindow best = {-1, "", 0, 0, 0, 0};
+    vector<pair<string, double>> modes = transport.getOptions(dest->name);
+    double baseRate = hotels.cheapestNightlyRate(dest->name);
+    if (modes.empty() || baseRate < 0 || nights < 1 || horizonDays < 1) return best;
+
+    // All modes share the destination's fare calendar, so the cheapest base fare stays cheapest
+    pair<string, double> cheapestMode = modes[0];
+    for (auto& mode : modes) {
+        if (mode.second < cheapestMode.second) cheapestMode = mode;
+    }
+
+    vector<double> nightly(horizonDays + nights);
+    for (int i = 0; i < (int)nightly.size(); i++) {
+        nightly[i] = hotels.nightlyRateOn(dest->name, baseRate, fromDay + i);
+    }
+    PriceIndex hotelIndex(fromDay, nightly);
+    int extraGuests = max(0, adults + children - 2);
+
+    for (int start = fromDay; start < fromDay + horizonDays; start++) {
+        double minTotal, maxTotal;
+        PreferenceTree::partyCostRange(dest, adults, children, start, minTotal, maxTotal);
+        double fare = transport.fareOn(dest->name, cheapestMode.second, start);
+        double transportCost = fare * adults + fare * 0.7 * children;
+        double hotelCost = hotelIndex.rangeSum(start, start + nights) +
+                           extraGuests * nightly[start - fromDay] * 0.5;
+        double total = minTotal + transportCost + hotelCost;
+        if (best.startDay < 0 || total < best.total) {
+            best = {start, cheapestMode.first, minTotal, transportCost, hotelCost, total};
         }
-        customer.displayDetails();
+    }
+    return best;
+}
 
-        PreferenceTree preferences;
-        
-        // ========== NATIONAL DESTINATIONS (20) ==========
-        // 1. Jaipur
-        preferences.addDestination(
-            "Jaipur", "National", "INR", 5000, 8000,
-            {"Amber Fort", "Hawa Mahal", "City Palace", "Jantar Mantar", "Nahargarh Fort"},
-            {"Dal Baati Churma", "Laal Maas", "Ghewar", "Kachori", "Mawa Kachori"},
-            {"Day 1: Arrival & City Palace", "Day 2: Amber Fort and markets", "Day 3: Hawa Mahal and departure"},
-            {"Day 1: Heritage walk", "Day 2: Forts tour", "Day 3: Shopping and food trail"},
-            {"Day 1: Arrival & Jantar Mantar", "Day 2: Combined palace tour", "Day 3: Relax and departure"},
-            true, true, "Warm (15-30°C)", "Not required", "October-March"
-        );
-        
-        // 2. Goa
-        preferences.addDestination(
-            "Goa", "National", "INR", 6000, 10000,
-            {"Beaches", "Dudhsagar Falls", "Old Goa Churches", "Fort Aguada", "Spice Plantations"},
-            {"Fish Curry Rice", "Bebinca", "Pork Vindaloo", "Feni", "Sorpotel"},
-            {"Day 1: North Goa beaches", "Day 2: Dudhsagar Falls", "Day 3: Old Goa sightseeing"},
-            {"Day 1: Beach hopping", "Day 2: Water sports", "Day 3: Relax and departure"},
-            {"Day 1: Arrival & local food", "Day 2: South Goa beaches", "Day 3: Sightseeing"},
-            true, true, "Humid (25-35°C)", "Not required", "November-February"
-        );
+// --------------------- TourPlanner ---------------------
+// Orders a multi-city circuit starting and ending at a home city and picks a
+// transport mode per leg. A leg to one of a city's listed nearby cities uses
+// the NearbyCity fares and distance, and a leg between home and a destination
+// uses the Transport fares quoted for that destination. Only the remaining
+// city-to-city legs are estimated with indicative per-km tariffs. Distances
+// and hours come from the great-circle distance (taken as 1.3x longer by rail
+// or road), and all fares follow the destination's seasonal calendar. Sets of up to 12 cities are solved
+// exactly with Held-Karp; larger sets use nearest-neighbour + 2-opt from every
+// starting city. Both spread independent work (DP states of one subset size,
+// or starting cities) across threads. When the fastest tour breaks the travel
+// budget, hours are priced against rupees at a rising rate (bisected) until
+// the tour fits.
+struct CityLocation {
+    const char* name;
+    double lat, lon;   // Main city or airport of the destination
+    bool domestic;     // Inside India: domestic rather than international air fares
+    bool byLand;       // On the Indian rail and road network
+};
 
-        // 3-20. More national destinations
-        vector<string> nationalDests = {
-            "Kerala", "Shimla", "Manali", "Darjeeling", "Munnar", 
-            "Udaipur", "Varanasi", "Amritsar", "Rishikesh", "Agra",
-            "Mysore", "Puducherry", "Andaman", "Ooty", "Kodaikanal",
-            "Khajuraho", "Ajanta-Ellora", "Hampi", "Leh-Ladakh", "Kashmir"
-        };
+struct TourLeg {
+    string from, to, mode;
+    double cost;  // For the whole party
+    double hours;
+    double km;
+};
 
-        vector<vector<string>> nationalAttractions = {
-            {"Backwaters", "Tea Gardens", "Alleppey Houseboat", "Kathakali Show"},
-            {"Mall Road", "Jakhu Temple", "Kufri", "Toy Train"},
-            {"Rohtang Pass", "Solang Valley", "Hadimba Temple", "Old Manali"},
-            {"Tiger Hill", "Batasia Loop", "Tea Gardens", "Himalayan Railway"},
-            {"Eravikulam Park", "Tea Museum", "Mattupetty Dam", "Echo Point"},
-            {"City Palace", "Lake Pichola", "Jag Mandir", "Sajjangarh"},
-            {"Ghats", "Kashi Vishwanath", "Sarnath", "Ganga Aarti"},
-            {"Golden Temple", "Jallianwala Bagh", "Wagah Border", "Partition Museum"},
-            {"River Rafting", "Beatles Ashram", "Laxman Jhula", "Ganga Aarti"},
-            {"Taj Mahal", "Agra Fort", "Fatehpur Sikri", "Mehtab Bagh"},
-            {"Mysore Palace", "Chamundi Hills", "Brindavan Gardens", "Zoo"},
-            {"Promenade Beach", "Auroville", "Paradise Beach", "French Quarter"},
-            {"Radhanagar Beach", "Cellular Jail", "Scuba Diving", "Limestone Caves"},
-            {"Botanical Gardens", "Ooty Lake", "Doddabetta Peak", "Tea Factory"},
-            {"Kodai Lake", "Pillar Rocks", "Coaker's Walk", "Bryant Park"},
-            {"Khajuraho Temples", "Light & Sound Show", "Panna National Park"},
-            {"Ajanta Caves", "Ellora Caves", "Bibi Ka Maqbara", "Grishneshwar Temple"},
-            {"Virupaksha Temple", "Vittala Temple", "Elephant Stables", "Lotus Mahal"},
-            {"Pangong Lake", "Nubra Valley", "Magnetic Hill", "Leh Palace"},
-            {"Dal Lake", "Gulmarg", "Pahalgam", "Shalimar Garden"}
-        };
+struct TourPlan {
+    vector<TourLeg> legs;
+    double travelCost;
+    double totalHours;
+    bool exact;         // Solved with Held-Karp rather than the heuristic
+    bool feasible;      // Every leg has at least one transport mode
+    bool withinBudget;  // Travel cost fits the travel budget (always true without one)
+    bool budgetLimited; // Faster modes were given up to fit the budget
+};
 
-        for(int i=0; i<nationalDests.size(); i++){
-            preferences.addDestination(
-                nationalDests[i], "National", "INR", 
-                4000 + (i*1000), 8000 + (i*1500),
-                nationalAttractions[i],
-                {"Local Cuisine 1", "Local Cuisine 2", "Special Dessert"},
-                {"Day 1: Arrival", "Day 2: Sightseeing", "Day 3: Departure"},
-                {"Day 1: Relax", "Day 2: Adventure", "Day 3: Culture"},
-                {"Day 1: Food Tour", "Day 2: Full day tour", "Day 3: Shopping"},
-                true, true, "Varies", "Not required", "Varies"
-            );
-        }
-
-        // ========== INTERNATIONAL DESTINATIONS (20) ==========
-        // 1. Vietnam
-        preferences.addDestination(
-            "Vietnam", "International", "VND", 30000, 50000,
-            {"Ha Long Bay", "Hoi An", "Hanoi Old Quarter", "Cu Chi Tunnels", "Mekong Delta"},
-            {"Pho", "Banh Mi", "Bun Cha", "Goi Cuon", "Cao Lau"},
-            {"Day 1: Hanoi arrival", "Day 2: Ha Long cruise", "Day 3: Hoi An"},
-            {"Day 1: Food tour", "Day 2: Cu Chi Tunnels", "Day 3: Mekong"},
-            {"Day 1: City tour", "Day 2: Countryside", "Day 3: Relax"},
-            true, true, "Tropical (20-35°C)", "Visa required", "November-April"
-        );
+class TourPlanner {
+private:
+    const Transport& transport;
+    const HotelAccommodation& hotels;
 
-        // 2-20. More international destinations
-        vector<string> intlDests = {
-            "Bali", "Thailand", "Singapore", "Malaysia", "Dubai",
-            "Turkey", "Japan", "South Korea", "France", "Italy",
-            "Switzerland", "Spain", "Greece", "Portugal", "Australia",
-            "New Zealand", "Maldives", "Sri Lanka", "Nepal", "Bhutan"
-        };
+    struct LegOption {
+        string mode;
+        double cost, hours, km;
+    };
 
-        vector<vector<string>> intlAttractions = {
-            {"Ubud", "Tanah Lot", "Uluwatu", "Tegallalang"},
-            {"Bangkok", "Phuket", "Chiang Mai", "Phi Phi Islands"},
-            {"Marina Bay", "Sentosa", "Gardens by the Bay", "Universal Studios"},
-            {"Kuala Lumpur", "Langkawi", "Penang", "Cameron Highlands"},
-            {"Burj Khalifa", "Palm Jumeirah", "Desert Safari", "Dubai Mall"},
-            {"Hagia Sophia", "Cappadocia", "Pamukkale", "Ephesus"},
-            {"Tokyo", "Kyoto", "Osaka", "Mount Fuji"},
-            {"Seoul", "Busan", "Jeju Island", "DMZ"},
-            {"Paris", "Nice", "Lyon", "French Riviera"},
-            {"Rome", "Venice", "Florence", "Amalfi Coast"},
-            {"Zurich", "Interlaken", "Lucerne", "Jungfraujoch"},
-            {"Barcelona", "Madrid", "Seville", "Ibiza"},
-            {"Athens", "Santorini", "Mykonos", "Crete"},
-            {"Lisbon", "Porto", "Algarve", "Madeira"},
-            {"Sydney", "Melbourne", "Great Barrier Reef", "Gold Coast"},
-            {"Auckland", "Queenstown", "Rotorua", "Milford Sound"},
-            {"Male", "Private Islands", "Underwater Restaurant"},
-            {"Colombo", "Kandy", "Galle", "Sigiriya"},
-            {"Kathmandu", "Pokhara", "Everest Base Camp", "Chitwan"},
-            {"Paro", "Thimphu", "Punakha", "Tiger's Nest"}
-        };
+    static const int exactLimit = 12;
 
-        vector<string> intlCurrencies = {
-            "IDR", "THB", "SGD", "MYR", "AED",
-            "TRY", "JPY", "KRW", "EUR", "EUR",
-            "CHF", "EUR", "EUR", "EUR", "AUD",
-            "NZD", "USD", "LKR", "NPR", "BTN"
+    static const CityLocation* findCity(const string& name) {
+        static const CityLocation cities[] = {
+            {"Delhi", 28.61, 77.21, true, true},        {"Mumbai", 19.08, 72.88, true, true},
+            {"Kolkata", 22.57, 88.36, true, true},      {"Chennai", 13.08, 80.27, true, true},
+            {"Bengaluru", 12.97, 77.59, true, true},    {"Hyderabad", 17.39, 78.49, true, true},
+            {"Pune", 18.52, 73.86, true, true},         {"Jaipur", 26.91, 75.79, true, true},
+            {"Ajmer", 26.45, 74.64, true, true},        {"Alwar", 27.55, 76.63, true, true},
+            {"Agra", 27.18, 78.01, true, true},         {"Goa", 15.50, 73.83, true, true},
+            {"Kerala", 9.93, 76.27, true, true},        {"Munnar", 10.09, 77.06, true, true},
+            {"Shimla", 31.10, 77.17, true, true},       {"Manali", 32.24, 77.19, true, true},
+            {"Darjeeling", 27.04, 88.26, true, true},   {"Udaipur", 24.59, 73.71, true, true},
+            {"Varanasi", 25.32, 82.97, true, true},     {"Amritsar", 31.63, 74.87, true, true},
+            {"Rishikesh", 30.09, 78.27, true, true},    {"Mysore", 12.30, 76.64, true, true},
+            {"Puducherry", 11.94, 79.81, true, true},   {"Ooty", 11.41, 76.70, true, true},
+            {"Kodaikanal", 10.24, 77.49, true, true},   {"Khajuraho", 24.85, 79.93, true, true},
+            {"Ajanta-Ellora", 19.88, 75.34, true, true}, {"Hampi", 15.34, 76.46, true, true},
+            {"Leh-Ladakh", 34.15, 77.58, true, true},   {"Kashmir", 34.08, 74.80, true, true},
+            {"Andaman", 11.62, 92.73, true, false},
+            {"Vietnam", 21.03, 105.85, false, false},   {"Cambodia", 11.56, 104.93, false, false},
+            {"Bali", -8.65, 115.22, false, false},      {"Thailand", 13.76, 100.50, false, false},
+            {"Singapore", 1.35, 103.82, false, false},  {"Malaysia", 3.14, 101.69, false, false},
+            {"Dubai", 25.20, 55.27, false, false},      {"Turkey", 41.01, 28.98, false, false},
+            {"Japan", 35.68, 139.69, false, false},     {"South Korea", 37.57, 126.98, false, false},
+            {"Russia", 55.76, 37.62, false, false},     {"France", 48.86, 2.35, false, false},
+            {"Italy", 41.90, 12.50, false, false},      {"Switzerland", 47.38, 8.54, false, false},
+            {"Spain", 40.42, -3.70, false, false},      {"Greece", 37.98, 23.73, false, false},
+            {"Portugal", 38.72, -9.14, false, false},   {"Australia", -33.87, 151.21, false, false},
+            {"New Zealand", -36.85, 174.76, false, false}, {"Maldives", 4.18, 73.51, false, false},
+            {"Sri Lanka", 6.93, 79.86, false, false},   {"Nepal", 27.72, 85.32, false, false},
+            {"Bhutan", 27.43, 89.42, false, false}
         };
+        for (auto& city : cities) {
+            if (toLower(city.name) == toLower(name)) return &city;
+        }
+        return NULL;
+    }
+
+    static double greatCircleKm(const CityLocation& a, const CityLocation& b) {
+        const double toRadians = M_PI / 180.0;
+        double dLat = (b.lat - a.lat) * toRadians, dLon = (b.lon - a.lon) * toRadians;
+        double h = sin(dLat / 2) * sin(dLat / 2) +
+                   cos(a.lat * toRadians) * cos(b.lat * toRadians) * sin(dLon / 2) * sin(dLon / 2);
+        return 2 * 6371.0 * asin(min(1.0, sqrt(h)));
+    }
+
+    // Door-to-door hours; km is the flown distance for flights, the surface distance otherwise
+    static double legHours(const string& mode, double km) {
+        string m = toLower(mode);
+        if (m == "flight") return 3.0 + km / 700.0; // Airport time plus cruise
+        if (m == "train") return km / 55.0;
+        if (m == "bus") return km / 45.0;
+        return km / 60.0; // Taxi and anything else by road
+    }
 
-        for(int i=0; i<intlDests.size(); i++){
-            preferences.addDestination(
-                intlDests[i], "International", intlCurrencies[i],
-                30000 + (i*5000), 60000 + (i*8000),
-                intlAttractions[i],
-                {"Local Specialty 1", "Local Specialty 2", "Famous Dish"},
-                {"Day 1: Arrival", "Day 2: Main Attraction", "Day 3: Culture"},
-                {"Day 1: Relax", "Day 2: Adventure", "Day 3: Food Tour"},
-                {"Day 1: City Tour", "Day 2: Full day tour", "Day 3: Shopping"},
-                true, true, "Varies", "Visa info varies", "Best season varies"
-            );
+    // Every way to travel from `from` to `to`, priced for the party
+    vector<LegOption> legOptions(const string& from, const string& to, const string& home,
+                                 int adults, int children, int travelDay) const {
+        vector<LegOption> options;
+        double party = adults + children * 0.7;
+        map<string, double> fares;
+        double km = 0;
+        if (hotels.getNearbyFares(from, to, fares, km) || hotels.getNearbyFares(to, from, fares, km)) {
+            for (auto& fare : fares) {
+                double adultFare = transport.fareOn(to, fare.second, travelDay);
+                options.push_back({fare.first, adultFare * party, legHours(fare.first, km), km});
+            }
+            return options;
         }
 
-        // ========== TRIP PLANNING FLOW ==========
-        cout << "\nSelect trip type:\n1. National\n2. International\n";
-        string tripTypeChoice;
-        getline(cin, tripTypeChoice);
-        
-        string tripType = (tripTypeChoice == "1") ? "National" : "International";
-        
-        preferences.showBudgetRanges(tripType, customer.tripPurpose, customer.adults, customer.children);
-        
-        cout << "\nSelect budget range (1-3): ";
-        string rangeChoice;
-        getline(cin, rangeChoice);
-        
-        Destination* selectedDest = preferences.selectDestinationFromRange(
-            tripType, customer.tripPurpose, customer.adults, customer.children, stoi(rangeChoice));
-        
-        if (!selectedDest) {
-            cout << "Invalid selection. Restarting...\n";
-            continue;
+        const CityLocation* a = findCity(from);
+        const CityLocation* b = findCity(to);
+        km = (a != NULL && b != NULL) ? greatCircleKm(*a, *b) : 0;
+        double surfaceKm = km * 1.3;
+
+        // Between home and a destination, the same fares the planner quotes for it
+        string destination = toLower(from) == toLower(home) ? to : toLower(to) == toLower(home) ? from : "";
+        if (!destination.empty()) {
+            for (auto& fare : transport.getOptions(destination)) {
+                double legKm = toLower(fare.first) == "flight" ? km : surfaceKm;
+                double adultFare = transport.fareOn(destination, fare.second, travelDay);
+                options.push_back({fare.first, adultFare * party, legHours(fare.first, legKm), legKm});
+            }
+            if (!options.empty()) return options;
         }
-        
-        preferences.showDestinationDetails(selectedDest, customer.adults, customer.children);
-        
-        Transport transport;
-        transport.showTransportOptions(selectedDest->name, customer.adults, customer.children);
-        
-        HotelAccommodation hotels;
-        cout << "\nEnter number of nights for stay: ";
-        string nightsInput;
-        getline(cin, nightsInput);
-        hotels.showHotelOptions(selectedDest->name, customer.adults, customer.children, stoi(nightsInput));
-        
-        cout << "\n====== TRIP SUMMARY ======\n";
-        cout << "Destination: " << selectedDest->name << "\nTravelers: " 
-             << customer.adults << " adults, " << customer.children << " children\n";
-        
-        cout << "\nBook another trip? (y/n): ";
-        string restartChoice;
-        getline(cin, restartChoice);
-        if (toLower(restartChoice) != "y") break;
+
+        if (a == NULL || b == NULL) return options;
+        // Indicative adult tariffs in INR
+        if (km >= 150) {
+            double fare = (a->domestic && b->domestic) ? 2500 + 3.5 * km : 8000 + 4.0 * km;
+            options.push_back({"Flight", transport.fareOn(to, fare, travelDay) * party,
+                               legHours("Flight", km), km});
+        }
+        if (a->byLand && b->byLand) {
+            options.push_back({"Train", transport.fareOn(to, 100 + 1.2 * surfaceKm, travelDay) * party,
+                               legHours("Train", surfaceKm), surfaceKm});
+            if (surfaceKm <= 1200) {
+                options.push_back({"Bus", transport.fareOn(to, 80 + 1.5 * surfaceKm, travelDay) * party,
+                                   legHours("Bus", surfaceKm), surfaceKm});
+            }
+        }
+        return options;
     }
-    
-    cout << "\nThank you for using Smart WanderPlan!\n";
-    return 0;
+
+    // Leg weight for the objective: hours plus rupees at `hoursPerRupee` when
+    // minimizing time, otherwise rupees with hours only breaking ties
+    static double legWeight(const LegOption& option, bool minimizeTime, double hoursPerRupee) {
+        return minimizeTime ? option.hours + hoursPerRupee * option.cost : option.cost + option.hours * 1e-3;
+    }
+
+    static int popcount(unsigned int x) {
+        int count = 0;
+        while (x) { x &= x - 1; count++; }
+        return count;
+    }
+
+    // Held-Karp over cities 1..n with node 0 = home; returns the visiting order
+    static vector<int> solveExact(const vector<vector<double>>& w, int n) {
+        const double INF = 1e18;
+        int full = 1 << n;
+        vector<double> dp((size_t)full * n, INF);
+        vector<int> parent((size_t)full * n, -1);
+        for (int i = 0; i < n; i++) dp[(size_t)(1 << i) * n + i] = w[0][i + 1];
+
+        vector<vector<int>> layers(n + 1);
+        for (int mask = 1; mask < full; mask++) layers[popcount(mask)].push_back(mask);
+
+        int numThreads = max(1, min<int>(8, thread::hardware_concurrency()));
+        for (int size = 2; size <= n; size++) {
+            const vector<int>& layer = layers[size];
+            auto work = [&](int t) {
+                for (size_t k = t; k < layer.size(); k += numThreads) {
+                    int mask = layer[k];
+                    for (int last = 0; last < n; last++) {
+                        if (!(mask & (1 << last))) continue;
+                        int prev = mask ^ (1 << last);
+                        double best = INF;
+                        int bestFrom = -1;
+                        for (int j = 0; j < n; j++) {
+                            if (!(prev & (1 << j))) continue;
+                            double value = dp[(size_t)prev * n + j] + w[j + 1][last + 1];
+                            if (value < best) { best = value; bestFrom = j; }
+                        }
+                        dp[(size_t)mask * n + last] = best;
+                        parent[(size_t)mask * n + last] = bestFrom;
+                    }
+                }
+            };
+            // Each layer only reads the previous one, so its masks are independent
+            if (layer.size() < 256) {
+                for (int t = 0; t < numThreads; t++) work(t); // Too small to be worth threads
+            } else {
+                vector<thread> workers;
+                for (int t = 0; t < numThreads; t++) workers.emplace_back(work, t);
+                for (auto& worker : workers) worker.join();
+            }
+        }
+
+        int last = 0;
+        double best = INF;
+        for (int i = 0; i < n; i++) {
+            double value = dp[(size_t)(full - 1) * n + i] + w[i + 1][0];
+            if (value < best) { best = value; last = i; }
+        }
+        vector<int> order;
+        int mask = full - 1;
+        while (last >= 0) {
+            order.push_back(last + 1);
+            int prev = parent[(size_t)mask * n + last];
+            mask ^= 1 << last;
+            last = prev;
+        }
+        reverse(order.begin(), order.end());
+        return order;
+    }
+
+    static double tourWeight(const vector<vector<double>>& w, const vector<int>& order) {
+        double total = w[0][order[0]] + w[order.back()][0];
+        for (size_t i = 1; i < order.size(); i++) total += w[order[i-1]][order[i]];
+        return total;
+    }
+
+    // Nearest neighbour from each possible first city, then bounded 2-opt
+    static vector<int> solveHeuristic(const vector<vector<double>>& w, int n) {
+        vector<vector<int>> candidates(n);
+        int numThreads = max(1, min<int>(n, thread::hardware_concurrency()));
+        vector<thread> workers;
+        for (int t = 0; t < numThreads; t++) {
+            workers.emplace_back([&, t]() {
+                for (int first = t; first < n; first += numThreads) {
+                    vector<int> order = {first + 1};
+                    vector<bool> used(n + 1, false);
+                    used[first + 1] = true;
+                    while ((int)order.size() < n) {
+                        int next = -1;
+                        for (int c = 1; c <= n; c++) {
+                            if (!used[c] && (next < 0 || w[order.back()][c] < w[order.back()][next])) next = c;
+                        }
+                        used[next] = true;
+                        order.push_back(next);
+                    }
+                    // Legs are not symmetric, so reversals are re-scored in full
+                    double current = tourWeight(w, order);
+                    for (int pass = 0; pass < 50; pass++) {
+                        bool improved = false;
+                        for (int i = 0; i + 1 < n; i++) {
+                            for (int j = i + 1; j < n; j++) {
+                                reverse(order.begin() + i, order.begin() + j + 1);
+                                double value = tourWeight(w, order);
+                                if (value + 1e-9 < current) { current = value; improved = true; }
+                                else reverse(order.begin() + i, order.begin() + j + 1);
+                            }
+                        }
+                        if (!improved) break;
+                    }
+                    candidates[first] = order;
+                }
+            });
+        }
+        for (auto& worker : workers) worker.join();
+
+        size_t best = 0;
+        for (size_t i = 1; i < candidates.size(); i++) {
+            if (tourWeight(w, candidates[i]) < tourWeight(w, candidates[best])) best = i;
+        }
+        return candidates[best];
+    }
+
+    // Picks the best mode per leg for the objective, then the visiting order
+    TourPlan solve(const vector<string>& names, const vector<vector<vector<LegOption>>>& options,
+                   bool minimizeTime, double hoursPerRupee) const {
+        int n = names.size() - 1;
+        const double UNREACHABLE = 1e12;
+        vector<vector<double>> weight(n + 1, vector<double>(n + 1, UNREACHABLE));
+        vector<vector<int>> choice(n + 1, vector<int>(n + 1, -1));
+        for (int i = 0; i <= n; i++) {
+            for (int j = 0; j <= n; j++) {
+                for (size_t k = 0; k < options[i][j].size(); k++) {
+                    double value = legWeight(options[i][j][k], minimizeTime, hoursPerRupee);
+                    if (choice[i][j] < 0 || value < weight[i][j]) {
+                        weight[i][j] = value;
+                        choice[i][j] = k;
+                    }
+                }
+            }
+        }
+
+        TourPlan result = {{}, 0, 0, n <= exactLimit, true, true, false};
+        vector<int> order = result.exact ? solveExact(weight, n) : solveHeuristic(weight, n);
+        vector<int> route = {0};
+        route.insert(route.end(), order.begin(), order.end());
+        route.push_back(0);
+        for (size_t k = 1; k < route.size(); k++) {
+            int i = route[k-1], j = route[k];
+            if (choice[i][j] < 0) {
+                result.feasible = false;
+                result.legs.push_back({names[i], names[j], "no transport", 0, 0, 0});
+                continue;
+            }
+            const LegOption& option = options[i][j][choice[i][j]];
+            result.legs.push_back({names[i], names[j], option.mode, option.cost, option.hours, option.km});
+            result.travelCost += option.cost;
+            result.totalHours += option.hours;
+        }
+        return result;
+    }
+
+public:
+    TourPlanner(const Transport& transport, const HotelAccommodation& hotels)
+        : transport(transport), hotels(hotels) {}
+
+    static bool hasLocation(const string& city) { return findCity(city) != NULL; }
+
+    // Plans a circuit from home through every city and back. Fares follow the
+    // seasonal calendars of travelDay (-1 for year-round fares). A travelBudget
+    // above zero caps the travel cost of a time-optimised tour.
+    TourPlan plan(const string& home, const vector<string>& cities, int adults, int children,
+                  bool minimizeTime, int travelDay = -1, double travelBudget = 0) const {
+        int n = cities.size();
+        if (n == 0) return {{}, 0, 0, true, true, true, false};
+
+        // Node 0 is home, node i is cities[i-1]
+        vector<string> names = {home};
+        names.insert(names.end(), cities.begin(), cities.end());
+        vector<vector<vector<LegOption>>> options(n + 1, vector<vector<LegOption>>(n + 1));
+        for (int i = 0; i <= n; i++) {
+            for (int j = 0; j <= n; j++) {
+                if (i != j) options[i][j] = legOptions(names[i], names[j], home, adults, children, travelDay);
+            }
+        }
+
+        TourPlan best = solve(names, options, minimizeTime, 0);
+        best.withinBudget = travelBudget <= 0 || best.travelCost <= travelBudget;
+        if (best.withinBudget || !minimizeTime || !best.feasible) return best;
+
+        // The fastest tour is over budget. If even the cheapest one is, report that;
+        // otherwise raise the price of an hour in rupees until the tour fits.
+        TourPlan cheapest = solve(names, options, false, 0);
+        cheapest.withinBudget = cheapest.travelCost <= travelBudget;
+        cheapest.budgetLimited = true;
+        if (!cheapest.withinBudget) return cheapest;
+
+        double low = 0, high = 1.0;
+        best = solve(names, options, true, high);
+        for (int i = 0; i < 6 && best.travelCost > travelBudget; i++) {
+            high *= 10;
+            best = solve(names, options, true, high);
+        }
+        if (best.travelCost > travelBudget) return cheapest;
+        for (int i = 0; i < 30; i++) {
+            double mid = (low + high) / 2;
+            TourPlan candidate = solve(names, options, true, mid);
+            if (candidate.travelCost <= travelBudget) {
+                best = candidate;
+                high = mid;
+            } else {
+                low = mid;
+            }
+        }
+        best.withinBudget = true;
+        best.budgetLimited = true;
+        return best;
+    }
+
+    void planTour(const PreferenceTree& preferences, int adults, int children, int travelDay = -1) const {
+        cout << "\nStarting city (press Enter for Delhi): ";
+        string home;
+        getline(cin, home);
+        home.erase(0, home.find_first_not_of(' '));
+        home.erase(home.find_last_not_of(' ') + 1);
+        if (home.empty()) home = "Delhi";
+        if (!hasLocation(home)) {
+            cout << "No travel data for " << home << ", starting from Delhi.\n";
+            home = "Delhi";
+        }
+        home = findCity(home)->name;
+
+        cout << "Enter destinations separated by commas (e.g. Jaipur, Agra, Varanasi): ";
+        string input;
+        getline(cin, input);
+        // Cities with travel data but no destination package (e.g. Mumbai) are
+        // still valid stops; they just add nothing to the package cost
+        vector<string> cities;
+        double packageCost = 0;
+        stringstream names(input);
+        string name;
+        while (getline(names, name, ',')) {
+            name.erase(0, name.find_first_not_of(' '));
+            name.erase(name.find_last_not_of(' ') + 1);
+            if (name.empty()) continue;
+            if (!hasLocation(name)) {
+                cout << "Unknown destination skipped: " << name << "\n";
+                continue;
+            }
+            name = findCity(name)->name;
+            bool duplicate = toLower(name) == toLower(home);
+            for (auto& city : cities) duplicate = duplicate || toLower(city) == toLower(name);
+            if (duplicate) continue;
+            const Destination* dest = preferences.getDestinationByName(name);
+            if (dest != NULL) {
+                double minTotal, maxTotal;
+                PreferenceTree::partyCostRange(dest, adults, children, travelDay, minTotal, maxTotal);
+                packageCost += minTotal;
+            }
+            cities.push_back(name);
+        }
+        if (cities.empty()) {
+            cout << "No valid destinations entered.\n";
+            return;
+        }
+
+        cout << "Total budget in INR: ";
+        string budgetInput;
+        getline(cin, budgetInput);
+        double budget = 0;
+        try {
+            budget = stod(budgetInput);
+        } catch (...) {
+            cout << "Invalid budget, skipping the budget check.\n";
+        }
+
+        cout << "Optimize for cost or time? (cost/time): ";
+        string objective;
+        getline(cin, objective);
+        bool minimizeTime = toLower(objective) == "time";
+
+        // Packages are fixed by the chosen cities, so only travel can give way
+        double travelBudget = budget > 0 ? max(1.0, budget - packageCost) : 0;
+        TourPlan tour = plan(home, cities, adults, children, minimizeTime, travelDay, travelBudget);
+        string label = !minimizeTime ? "cheapest" : !tour.budgetLimited ? "fastest" :
+                       tour.withinBudget ? "fastest within budget" : "cheapest; no tour fits the budget";
+        cout << "\n--- Multi-City Tour (" << label
+             << (tour.exact ? ", optimal order" : ", heuristic order") << ") ---\n";
+        cout << fixed << setprecision(0);
+        for (size_t i = 0; i < tour.legs.size(); i++) {
+            const TourLeg& leg = tour.legs[i];
+            cout << (i+1) << ". " << leg.from << " -> " << leg.to << " by " << leg.mode;
+            if (leg.km > 0) {
+                cout << " (~" << leg.km << " km): " << leg.cost << " INR, ~"
+                     << setprecision(1) << leg.hours << setprecision(0) << " hrs";
+            }
+            cout << "\n";
+        }
+        if (!tour.feasible) {
+            cout << "Some legs have no transport options; the tour cannot be booked as planned.\n";
+        }
+        if (minimizeTime && tour.budgetLimited && tour.withinBudget) {
+            cout << "Slower, cheaper modes were chosen on some legs to stay within budget.\n";
+        }
+        double total = packageCost + tour.travelCost;
+        cout << "\nTravel cost: " << tour.travelCost << " INR\n";
+        cout << "Destination packages (minimum): " << packageCost << " INR\n";
+        cout << "Estimated total: " << total << " INR, ~" << setprecision(1) << tour.totalHours
+             << setprecision(0) << " hrs of travel\n";
+        if (budget > 0) {
+            if (total <= budget) cout << "Within your budget of " << budget << " INR.\n";
+            else cout << "Over your budget of " << budget << " INR by " << (total - budget) << " INR.\n";
+        }
+    }
+};
+
+// --------------------- CostRiskForecaster ---------------------
+// Monte Carlo model of a package's final cost. Per simulated trip:
+//   destination spend  ~ uniform over the party's min-max range
+//   transport fare     ~ lognormal around the quoted fare
+//   nightly hotel rate ~ lognormal around the quoted rate
+//   exchange rate      ~ normal drift around convertCurrency's rate, applied to
+//                        spend paid in the local currency (package and hotel)
+// Random numbers come from a counter-based generator (a 32-bit hash of the
+// trip index and a per-stream key), so trip i always sees the same draws
+// whatever the thread count. The generator uses 32-bit multiplies only and
+// log/exp/sin/cos are branch-free polynomials, so both batch loops vectorise
+// at -O2 without -ffast-math (check with -fopt-info-vec-optimized).
+struct TripPackage {
+    double packageMin, packageMax; // Party totals in INR
+    double adultFare;              // 0 when no transport is quoted
+    double nightlyRate;            // 0 when no hotel is quoted
+    int adults, children, nights;
+    string currency;
+};
+
+struct RiskForecast {
+    long long simulations;
+    double mean, p5, p50, p90, p95, p99;
+    double overBudgetProbability;
+    double elapsedMs;
+};
+
+class CostRiskForecaster {
+private:
+    double fareVolatility, rateVolatility, fxVolatility;
+
+    static inline unsigned long long splitmix64(unsigned long long x) {
+        x += 0x9E3779B97F4A7C15ull;
+        x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+        x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+        return x ^ (x >> 31);
+    }
+
+    // lowbias32 integer hash
+    static inline uint32_t hash32(uint32_t x) {
+        x ^= x >> 16;
+        x *= 0x7FEB352Du;
+        x ^= x >> 15;
+        x *= 0x846CA68Bu;
+        return x ^ (x >> 16);
+    }
+
+    // Uniform in (0, 1) from the top 24 bits; single precision is plenty for
+    // cost percentiles
+    static inline float toUnit(uint32_t bits) {
+        return ((int32_t)(bits >> 8) + 0.5f) * (1.0f / 16777216.0f);
+    }
+
+    static inline float fromBits(uint32_t bits) {
+        float f;
+        memcpy(&f, &bits, sizeof(f));
+        return f;
+    }
+
+    static inline uint32_t toBits(float f) {
+        uint32_t bits;
+        memcpy(&bits, &f, sizeof(bits));
+        return bits;
+    }
+
+    // Natural log for normal x > 0 (Cephes logf polynomial, ~1e-7 relative)
+    static inline float fastLog(float x) {
+        uint32_t bits = toBits(x);
+        uint32_t mantissa = bits & 0x007FFFFFu;
+        // x = 2^e * m with m in [sqrt(1/2), sqrt(2)); integer selects keep this
+        // free of conditional float arithmetic, which -ftrapping-math won't if-convert
+        int32_t small = mantissa < 0x3504F3u; // Mantissa bits of sqrt(2)
+        float e = (float)((int32_t)(bits >> 23) - 126 - small);
+        float m = fromBits(mantissa | (small ? 0x3F800000u : 0x3F000000u)) - 1.0f;
+        float z = m * m;
+        float y = 7.0376836292e-2f;
+        y = y * m - 1.1514610310e-1f;
+        y = y * m + 1.1676998740e-1f;
+        y = y * m - 1.2420140846e-1f;
+        y = y * m + 1.4249322787e-1f;
+        y = y * m - 1.6668057665e-1f;
+        y = y * m + 2.0000714765e-1f;
+        y = y * m - 2.4999993993e-1f;
+        y = y * m + 3.3333331174e-1f;
+        y = y * m * z - 2.12194440e-4f * e - 0.5f * z;
+        return m + y + 0.693359375f * e;
+    }
+
+    // sqrt for x > 0: bit-trick reciprocal square root refined by three Newton
+    // steps (sqrtf would keep its errno branch and block vectorisation)
+    static inline float fastSqrt(float x) {
+        float y = fromBits(0x5F3759DFu - (toBits(x) >> 1));
+        y = y * (1.5f - 0.5f * x * y * y);
+        y = y * (1.5f - 0.5f * x * y * y);
+        y = y * (1.5f - 0.5f * x * y * y);
+        return x * y;
+    }
+
+    // e^x for |x| < 87 (range reduction by ln 2, degree-6 polynomial, ~2e-7 relative).
+    // Callers pass volatility * z with |z| < 6, far inside the range.
+    static inline float fastExp(float x) {
+        float k = (float)(int32_t)(x * 1.44269504f + (x < 0 ? -0.5f : 0.5f));
+        float r = x - k * 0.693359375f + k * 2.12194440e-4f;
+        float p = 1.0f / 720;
+        p = p * r + 1.0f / 120;
+        p = p * r + 1.0f / 24;
+        p = p * r + 1.0f / 6;
+        p = p * r + 0.5f;
+        p = p * r + 1.0f;
+        p = p * r + 1.0f;
+        return p * fromBits((uint32_t)((int32_t)k + 127) << 23);
+    }
+
+    // sin and cos of 2*pi*u for u in [0, 1], via the half angle h = pi*(u - 0.5)
+    // in [-pi/2, pi/2] where short Taylor series are accurate to ~1e-7
+    static inline void sinCosTurn(float u, float& sine, float& cosine) {
+        float h = 3.14159265f * (u - 0.5f);
+        float h2 = h * h;
+        float sh = h * (1.0f + h2 * (-1.0f / 6 + h2 * (1.0f / 120 + h2 * (-1.0f / 5040 +
+                   h2 * (1.0f / 362880 - h2 * (1.0f / 39916800))))));
+        float ch = 1.0f + h2 * (-0.5f + h2 * (1.0f / 24 + h2 * (-1.0f / 720 + h2 * (1.0f / 40320 +
+                   h2 * (-1.0f / 3628800 + h2 * (1.0f / 479001600))))));
+        // 2*pi*u = 2h + pi
+        sine = -2.0f * sh * ch;
+        cosine = 2.0f * sh * sh - 1.0f;
+    }
+
+    static const int batchSize = 256;
+
+    // Batches always cover batchSize trips (a short last batch just discards the
+    // rest), so the fixed-length loops need no scalar epilogue
+    void simulateRange(const TripPackage& trip, double fxSigma, unsigned long long seed,
+                       long long first, long long last, float* totals) const {
+        float u[5][batchSize];
+        float batch[batchSize];
+        uint32_t keys[5];
+        for (int s = 0; s < 5; s++) keys[s] = (uint32_t)splitmix64(seed ^ (0xA24BAED4963EE407ull * (s + 1)));
+        float fareVol = fareVolatility, rateVol = rateVolatility, fxVol = fxSigma;
+        float fareDrift = 0.5f * fareVol * fareVol;
+        float rateDrift = 0.5f * rateVol * rateVol;
+        float adultFare = trip.adultFare, nightlyRate = trip.nightlyRate;
+        float packageMin = trip.packageMin, packageSpan = trip.packageMax - trip.packageMin;
+        float partyFactor = trip.adults + trip.children * 0.7f;
+        float hotelNights = trip.nights + max(0, trip.adults + trip.children - 2) * 0.5f;
+        for (long long start = first; start < last; start += batchSize) {
+            uint32_t base = (uint32_t)start;
+            // Five independent uniform streams per trip
+            for (int s = 0; s < 5; s++) {
+                uint32_t key = keys[s];
+                for (int i = 0; i < batchSize; i++) {
+                    u[s][i] = toUnit(hash32(hash32(base + i + key) ^ key));
+                }
+            }
+            for (int i = 0; i < batchSize; i++) {
+                // Box-Muller: a pair of normals from streams 0-1, a third from 2-3
+                float sine, cosine, sine3, cosine3;
+                sinCosTurn(u[1][i], sine, cosine);
+                sinCosTurn(u[3][i], sine3, cosine3);
+                float radius = fastSqrt(-2.0f * fastLog(u[0][i]));
+                float z1 = radius * cosine;
+                float z2 = radius * sine;
+                float z3 = fastSqrt(-2.0f * fastLog(u[2][i])) * cosine3;
+
+                float fare = adultFare * fastExp(fareVol * z1 - fareDrift);
+                float rate = nightlyRate * fastExp(rateVol * z2 - rateDrift);
+                float fx = 1.0f + fxVol * z3;
+                fx = fx < 0.5f ? 0.5f : fx; // Local currency per INR, relative to today
+                float package = packageMin + packageSpan * u[4][i];
+                batch[i] = fare * partyFactor + (package + rate * hotelNights) / fx;
+            }
+            int count = (int)min<long long>(batchSize, last - start);
+            memcpy(totals + (start - first), batch, count * sizeof(float));
+        }
+    }
+
+    static size_t rankOf(size_t n, double p) {
+        return (size_t)min<double>(n - 1, floor(p / 100.0 * n));
+    }
+
+    // Selects the p-th percentile within [from, to) of a partially partitioned array
+    static double percentile(vector<float>& values, double p, size_t from, size_t to) {
+        size_t k = rankOf(values.size(), p);
+        from = min(from, k); // Tiny samples can share ranks between percentiles
+        to = max(to, k + 1);
+        nth_element(values.begin() + from, values.begin() + k, values.begin() + to);
+        return values[k];
+    }
+
+public:
+    CostRiskForecaster(double fareVolatility = 0.18, double rateVolatility = 0.12, double fxVolatility = 0.05)
+        : fareVolatility(fareVolatility), rateVolatility(rateVolatility), fxVolatility(fxVolatility) {}
+
+    RiskForecast forecast(const TripPackage& trip, double budget, long long simulations,
+                          unsigned long long seed = 2024) const {
+        auto startTime = chrono::steady_clock::now();
+        simulations = max(1LL, simulations);
+        // Only currencies in convertCurrency's table carry exchange-rate risk
+        bool knownCurrency = trip.currency != "INR" && convertCurrency(1.0, "INR", trip.currency) != 1.0;
+        double fxSigma = knownCurrency ? fxVolatility : 0.0;
+
+        vector<float> totals(simulations);
+        int numThreads = max(1, (int)min<long long>(thread::hardware_concurrency(), simulations / 10000 + 1));
+        long long chunk = (simulations + numThreads - 1) / numThreads;
+        vector<thread> workers;
+        for (int t = 0; t < numThreads; t++) {
+            long long first = t * chunk, last = min(simulations, first + chunk);
+            if (first >= last) break;
+            workers.emplace_back([&, first, last]() {
+                simulateRange(trip, fxSigma, seed, first, last, &totals[first]);
+            });
+        }
+        for (auto& w : workers) w.join();
+
+        RiskForecast result;
+        result.simulations = simulations;
+        double sum = 0;
+        long long over = 0;
+        for (float total : totals) {
+            sum += total;
+            if (budget > 0 && total > budget) over++;
+        }
+        result.mean = sum / simulations;
+        result.overBudgetProbability = (double)over / simulations;
+        // Each selection partitions the array, so later ones only search the tail above it
+        size_t n = totals.size();
+        result.p50 = percentile(totals, 50, 0, n);
+        result.p5 = percentile(totals, 5, 0, rankOf(n, 50));
+        result.p90 = percentile(totals, 90, rankOf(n, 50) + 1, n);
+        result.p95 = percentile(totals, 95, rankOf(n, 90) + 1, n);
+        result.p99 = percentile(totals, 99, rankOf(n, 95) + 1, n);
+        result.elapsedMs = chrono::duration<double, milli>(chrono::steady_clock::now() - startTime).count();
+        return result;
+    }
+
+    static void printForecast(const RiskForecast& risk, double budget) {
+        cout << "\n--- Trip Cost Risk Forecast (" << risk.simulations << " simulated trips) ---\n";
+        cout << fixed << setprecision(0);
+        cout << "Expected cost: " << risk.mean << " INR\n";
+        cout << "Likely range (5th-95th percentile): " << risk.p5 << " - " << risk.p95 << " INR\n";
+        cout << "Median: " << risk.p50 << " INR, 90th: " << risk.p90 << " INR, 99th: " << risk.p99 << " INR\n";
+        if (budget > 0) {
+            cout << "Chance of exceeding " << budget << " INR: "
+                 << setprecision(1) << risk.overBudgetProbability * 100 << "%\n";
+        }
+    }
+};
+
+// --------------------- ItineraryGenerator ---------------------
+// Builds N-day itineraries from a destination's attractions. Each candidate
+// clusters the attractions into days (k-means with a per-day hour budget),
+// orders every day with nearest-neighbour + 2-opt, and is scored by total
+// travel plus a penalty for attractions left unscheduled. Candidates run in
+// parallel; each uses its own seed, so the chosen plan does not depend on the
+// number of threads.
+struct ItineraryDay {
+    vector<int> stops; // Indices into the attraction list, in visiting order
+    double visitHours;
+    double travelKm;
+};
+
+struct Itinerary {
+    vector<ItineraryDay> days;
+    vector<int> unscheduled;
+    double totalTravelKm;
+    double score;
+};
+
+class ItineraryGenerator {
+private:
+    unsigned int seed;
+    int candidates;
+    double hoursPerDay;
+
+    static double distance(const AttractionInfo& a, const AttractionInfo& b) {
+        return hypot(a.x - b.x, a.y - b.y);
+    }
+
+    static double routeLength(const vector<AttractionInfo>& attr, const vector<int>& route) {
+        double total = 0;
+        for (size_t i = 1; i < route.size(); i++) total += distance(attr[route[i-1]], attr[route[i]]);
+        return total;
+    }
+
+    // Open-path TSP heuristic: nearest neighbour from the stop closest to the
+    // day's centre, then 2-opt until no improving reversal remains
+    static vector<int> orderStops(const vector<AttractionInfo>& attr, vector<int> stops,
+                                  double cx, double cy) {
+        if (stops.size() < 3) return stops;
+        vector<int> route;
+        size_t start = 0;
+        for (size_t i = 1; i < stops.size(); i++) {
+            if (hypot(attr[stops[i]].x - cx, attr[stops[i]].y - cy) <
+                hypot(attr[stops[start]].x - cx, attr[stops[start]].y - cy)) start = i;
+        }
+        route.push_back(stops[start]);
+        stops.erase(stops.begin() + start);
+        while (!stops.empty()) {
+            size_t next = 0;
+            for (size_t i = 1; i < stops.size(); i++) {
+                if (distance(attr[route.back()], attr[stops[i]]) <
+                    distance(attr[route.back()], attr[stops[next]])) next = i;
+            }
+            route.push_back(stops[next]);
+            stops.erase(stops.begin() + next);
+        }
+
+        bool improved = true;
+        while (improved) {
+            improved = false;
+            for (size_t i = 0; i + 1 < route.size(); i++) {
+                for (size_t j = i + 1; j < route.size(); j++) {
+                    // Reversing route[i..j] only changes the edges at both ends
+                    double before = 0, after = 0;
+                    if (i > 0) {
+                        before += distance(attr[route[i-1]], attr[route[i]]);
+                        after += distance(attr[route[i-1]], attr[route[j]]);
+                    }
+                    if (j + 1 < route.size()) {
+                        before += distance(attr[route[j]], attr[route[j+1]]);
+                        after += distance(attr[route[i]], attr[route[j+1]]);
+                    }
+                    if (after + 1e-9 < before) {
+                        reverse(route.begin() + i, route.begin() + j + 1);
+                        improved = true;
+                    }
+                }
+            }
+        }
+        return route;
+    }
+
+    Itinerary buildCandidate(const vector<AttractionInfo>& attr, int numDays, unsigned int candidateSeed) const {
+        int n = attr.size();
+        int k = min(numDays, n);
+        mt19937 rng(candidateSeed);
+        vector<double> cx, cy;
+
+        // k-means++ seeding
+        if (k > 0) {
+            int first = uniform_int_distribution<int>(0, n - 1)(rng);
+            cx.push_back(attr[first].x);
+            cy.push_back(attr[first].y);
+        }
+        while ((int)cx.size() < k) {
+            vector<double> weights(n);
+            for (int i = 0; i < n; i++) {
+                double best = 1e18;
+                for (size_t c = 0; c < cx.size(); c++) {
+                    double dx = attr[i].x - cx[c], dy = attr[i].y - cy[c];
+                    best = min(best, dx*dx + dy*dy);
+                }
+                weights[i] = best;
+            }
+            int pick;
+            double sum = 0;
+            for (double w : weights) sum += w;
+            if (sum <= 0) pick = uniform_int_distribution<int>(0, n - 1)(rng);
+            else pick = discrete_distribution<int>(weights.begin(), weights.end())(rng);
+            cx.push_back(attr[pick].x);
+            cy.push_back(attr[pick].y);
+        }
+
+        // Lloyd iterations on the unconstrained problem
+        vector<int> cluster(n, 0);
+        for (int iter = 0; iter < 10 && k > 0; iter++) {
+            for (int i = 0; i < n; i++) {
+                int best = 0;
+                for (int c = 1; c < k; c++) {
+                    if (hypot(attr[i].x - cx[c], attr[i].y - cy[c]) <
+                        hypot(attr[i].x - cx[best], attr[i].y - cy[best])) best = c;
+                }
+                cluster[i] = best;
+            }
+            vector<double> sx(k, 0), sy(k, 0);
+            vector<int> count(k, 0);
+            for (int i = 0; i < n; i++) {
+                sx[cluster[i]] += attr[i].x;
+                sy[cluster[i]] += attr[i].y;
+                count[cluster[i]]++;
+            }
+            for (int c = 0; c < k; c++) {
+                if (count[c] > 0) { cx[c] = sx[c] / count[c]; cy[c] = sy[c] / count[c]; }
+            }
+        }
+
+        // Capacity-constrained assignment: attractions earlier in the list are
+        // the headline sights, so they claim day slots first
+        Itinerary plan;
+        plan.days.assign(numDays, ItineraryDay{{}, 0, 0});
+        for (int i = 0; i < n; i++) {
+            vector<int> order(k);
+            for (int c = 0; c < k; c++) order[c] = c;
+            sort(order.begin(), order.end(), [&](int a, int b) {
+                return hypot(attr[i].x - cx[a], attr[i].y - cy[a]) <
+                       hypot(attr[i].x - cx[b], attr[i].y - cy[b]);
+            });
+            bool placed = false;
+            for (int c : order) {
+                if (plan.days[c].visitHours + attr[i].visitHours <= hoursPerDay) {
+                    plan.days[c].stops.push_back(i);
+                    plan.days[c].visitHours += attr[i].visitHours;
+                    placed = true;
+                    break;
+                }
+            }
+            if (!placed) plan.unscheduled.push_back(i);
+        }
+
+        plan.totalTravelKm = 0;
+        double unscheduledHours = 0;
+        for (int c = 0; c < k; c++) {
+            plan.days[c].stops = orderStops(attr, plan.days[c].stops, cx[c], cy[c]);
+            plan.days[c].travelKm = routeLength(attr, plan.days[c].stops);
+            plan.totalTravelKm += plan.days[c].travelKm;
+        }
+        for (int i : plan.unscheduled) unscheduledHours += attr[i].visitHours;
+        // An unscheduled hour costs as much as 20 km of extra driving
+        plan.score = plan.totalTravelKm + unscheduledHours * 20.0;
+
+        // Visit the day holding the top-listed attraction first
+        sort(plan.days.begin(), plan.days.end(), [](const ItineraryDay& a, const ItineraryDay& b) {
+            if (a.stops.empty() != b.stops.empty()) return !a.stops.empty();
+            if (a.stops.empty()) return false;
+            return *min_element(a.stops.begin(), a.stops.end()) < *min_element(b.stops.begin(), b.stops.end());
+        });
+        return plan;
+    }
+
+public:
+    ItineraryGenerator(unsigned int seed = 42, int candidates = 16, double hoursPerDay = 8.0)
+        : seed(seed), candidates(max(1, candidates)), hoursPerDay(hoursPerDay) {}
+
+    Itinerary generate(const vector<AttractionInfo>& attractions, int numDays) const {
+        if (numDays < 1) numDays = 1;
+        vector<Itinerary> results(candidates);
+        int numThreads = max(1, min<int>(candidates, thread::hardware_concurrency()));
+        vector<thread> workers;
+        for (int t = 0; t < numThreads; t++) {
+            workers.emplace_back([&, t]() {
+                for (int c = t; c < candidates; c += numThreads) {
+                    results[c] = buildCandidate(attractions, numDays, seed + c * 7919u);
+                }
+            });
+        }
+        for (auto& w : workers) w.join();
+
+        size_t best = 0;
+        for (size_t c = 1; c < results.size(); c++) {
+            if (results[c].score < results[best].score) best = c;
+        }
+        return results[best];
+    }
+
+    static void printItinerary(const Itinerary& plan, const vector<AttractionInfo>& attractions,
+                               const string& destination) {
+        cout << "\n--- Your " << plan.days.size() << "-Day Itinerary for " << destination << " ---\n";
+        for (size_t d = 0; d < plan.days.size(); d++) {
+            const ItineraryDay& day = plan.days[d];
+            cout << "Day " << (d+1) << ": ";
+            if (day.stops.empty()) {
+                cout << "Leisure day / local exploration\n";
+                continue;
+            }
+            for (size_t i = 0; i < day.stops.size(); i++) {
+                if (i > 0) cout << " -> ";
+                cout << attractions[day.stops[i]].name;
+            }
+            cout << fixed << setprecision(1) << "\n   (" << day.visitHours << " hrs sightseeing, "
+                 << day.travelKm << " km between stops)\n";
+        }
+        if (!plan.unscheduled.empty()) {
+            cout << "Not enough time for: ";
+            for (size_t i = 0; i < plan.unscheduled.size(); i++) {
+                if (i > 0) cout << ", ";
+                cout << attractions[plan.unscheduled[i]].name;
+            }
+            cout << "\n";
+        }
+    }
+};
+
+// --------------------- Session Record & Replay ---------------------
+// Session logs hold one input line per entry, preceded by the think time in
+// milliseconds since the previous line. The header pins the recording date
+// and the footer holds a hash of the planner's output and its exit status,
+// which every replay must reproduce:
+//   # wanderplan session v2
+//   # today 2026-10-18
+//   1520<TAB>Harshitha
+//   2210<TAB>9876543210
+//   ...
+//   # output 8f18b48e1dab502b
+//   # status 0
+// v1 logs have no date or footer; their replays are only checked against
+// each other.
+
+// 64-bit FNV-1a; pass the previous result as `h` to hash data in pieces
+unsigned long long fnv64(const char* data, size_t length, unsigned long long h = 14695981039346656037ull) {
+    for (size_t i = 0; i < length; i++) {
+        h ^= (unsigned char)data[i];
+        h *= 1099511628211ull;
+    }
+    return h;
+}
+
+// Passes output through to another buffer while hashing it
+class OutputDigest : public streambuf {
+private:
+    streambuf* sink;
+    unsigned long long hash;
+
+protected:
+    int overflow(int c) override {
+        if (c == traits_type::eof()) return traits_type::not_eof(c);
+        char ch = (char)c;
+        hash = fnv64(&ch, 1, hash);
+        return sink->sputc(ch);
+    }
+
+    streamsize xsputn(const char* data, streamsize count) override {
+        hash = fnv64(data, count, hash);
+        return sink->sputn(data, count);
+    }
+
+    int sync() override { return sink->pubsync(); }
+
+public:
+    OutputDigest(streambuf* sink) : sink(sink), hash(fnv64(NULL, 0)) {}
+
+    unsigned long long value() const { return hash; }
+};
+
+class SessionRecorder : public streambuf {
+private:
+    streambuf* source;
+    ofstream log;
+    string line;
+    chrono::steady_clock::time_point lastInput;
+
+protected:
+    int underflow() override {
+        if (gptr() < egptr()) return traits_type::to_int_type(*gptr());
+        line.clear();
+        int c;
+        while ((c = source->sbumpc()) != traits_type::eof()) {
+            line += (char)c;
+            if (c == '\n') break;
+        }
+        if (line.empty()) return traits_type::eof();
+
+        auto now = chrono::steady_clock::now();
+        long long delay = chrono::duration_cast<chrono::milliseconds>(now - lastInput).count();
+        lastInput = now;
+        string entry = line;
+        if (!entry.empty() && entry.back() == '\n') entry.pop_back();
+        log << delay << "\t" << entry << "\n" << flush;
+
+        setg(&line[0], &line[0], &line[0] + line.size());
+        return traits_type::to_int_type(*gptr());
+    }
+
+public:
+    SessionRecorder(streambuf* source, const string& path) : source(source), log(path) {
+        log << "# wanderplan session v2\n";
+        log << "# today " << formatDate(todayDayNumber()) << "\n";
+        lastInput = chrono::steady_clock::now();
+    }
+
+    bool isOpen() const { return log.is_open(); }
+
+    // Records what a replay of this session has to reproduce
+    void finish(int status, unsigned long long outputHash) {
+        log << "# output " << hex << outputHash << dec << "\n";
+        log << "# status " << status << "\n" << flush;
+    }
+};
+
+struct SessionEvent {
+    long long delayMs;
+    string input;
+};
+
+struct SessionLog {
+    vector<SessionEvent> events;
+    string today;                    // Recording date (YYYY-MM-DD); empty in v1 logs
+    bool hasExpected = false;        // v2 footer present
+    unsigned long long expectedHash = 0;
+    int expectedStatus = 0;
+};
+
+bool loadSessionLog(const string& path, SessionLog& session) {
+    ifstream in(path);
+    if (!in) return false;
+    string line;
+    bool hasHash = false, hasStatus = false;
+    while (getline(in, line)) {
+        try {
+            if (line.compare(0, 8, "# today ") == 0) {
+                session.today = line.substr(8);
+            } else if (line.compare(0, 9, "# output ") == 0) {
+                session.expectedHash = stoull(line.substr(9), nullptr, 16);
+                hasHash = true;
+            } else if (line.compare(0, 9, "# status ") == 0) {
+                session.expectedStatus = stoi(line.substr(9));
+                hasStatus = true;
+            }
+            if (line.empty() || line[0] == '#') continue;
+            size_t tab = line.find('\t');
+            if (tab == string::npos) return false;
+            session.events.push_back({stoll(line.substr(0, tab)), line.substr(tab + 1)});
+        } catch (...) {
+            return false;
+        }
+    }
+    session.hasExpected = hasHash && hasStatus;
+    return true;
+}
+
+struct ReplayResult {
+    bool ran;                   // False when an open-loop arrival was dropped
+    bool ok;                    // Finished in time with the expected exit status
+    double latencyMs;           // Wall time minus scripted think time
+    double startLagMs;          // Open loop: start time past the scheduled arrival
+    unsigned long long outputHash;
+};
+
+struct ReplayOptions {
+    int users = 4;              // Concurrent users (closed loop)
+    int sessions = 100;         // Total sessions to run
+    double rate = 0;            // Arrivals per second; > 0 selects open loop
+    int maxInFlight = 64;       // Open loop: arrivals beyond this many running sessions are dropped
+    double thinkScale = 0;      // Multiplier on recorded think times
+    int timeoutSeconds = 30;
+    unsigned int seed = 42;
+};
+
+class SessionReplayer {
+private:
+    string executable;
+    SessionLog session;
+    ReplayOptions options;
+    vector<string> environment; // Child environment, prepared before any fork
+    vector<char*> envp;
+
+    static const int lateThresholdMs = 10;
+
+    // Runs one session against a fresh planner process, feeding inputs on
+    // schedule while draining its output
+    ReplayResult runSession() const {
+        const vector<SessionEvent>& events = session.events;
+        ReplayResult result = {true, false, 0, 0, 0};
+        int toChild[2], fromChild[2];
+        if (pipe(toChild) != 0) return result;
+        if (pipe(fromChild) != 0) {
+            close(toChild[0]); close(toChild[1]);
+            return result;
+        }
+
+        auto start = chrono::steady_clock::now();
+        pid_t pid = fork();
+        if (pid == 0) {
+            dup2(toChild[0], STDIN_FILENO);
+            dup2(fromChild[1], STDOUT_FILENO);
+            close(toChild[0]); close(toChild[1]);
+            close(fromChild[0]); close(fromChild[1]);
+            execle(executable.c_str(), executable.c_str(), (char*)NULL, envp.data());
+            _exit(127);
+        }
+        close(toChild[0]);
+        close(fromChild[1]);
+        if (pid < 0) {
+            close(toChild[1]); close(fromChild[0]);
+            return result;
+        }
+
+        string output;
+        int writeFd = toChild[1];
+        size_t next = 0;
+        long long thinkMs = 0;
+        auto due = start;
+        string pending;
+        char buffer[4096];
+        bool timedOut = false;
+
+        while (true) {
+            auto now = chrono::steady_clock::now();
+            if (now - start > chrono::seconds(options.timeoutSeconds)) {
+                timedOut = true;
+                break;
+            }
+            // Queue the next input line once its think time has elapsed
+            if (writeFd >= 0 && pending.empty()) {
+                if (next < events.size()) {
+                    if (next == 0 || now >= due) {
+                        pending = events[next].input + "\n";
+                        next++;
+                        if (next < events.size()) {
+                            long long delay = (long long)(events[next].delayMs * options.thinkScale);
+                            thinkMs += delay;
+                            due = now + chrono::milliseconds(delay);
+                        }
+                    }
+                } else {
+                    close(writeFd);
+                    writeFd = -1;
+                }
+            }
+
+            pollfd fds[2];
+            int count = 0;
+            fds[count++] = {fromChild[0], POLLIN, 0};
+            if (writeFd >= 0 && !pending.empty()) fds[count++] = {writeFd, POLLOUT, 0};
+            int waitMs = 100;
+            if (writeFd >= 0 && pending.empty() && next < events.size()) {
+                waitMs = (int)max<long long>(0, min<long long>(100,
+                    chrono::duration_cast<chrono::milliseconds>(due - now).count()));
+            }
+            if (poll(fds, count, waitMs) < 0) break;
+
+            if (fds[0].revents & (POLLIN | POLLHUP)) {
+                ssize_t n = read(fromChild[0], buffer, sizeof(buffer));
+                if (n <= 0) break; // Planner closed its output
+                output.append(buffer, n);
+            }
+            if (count > 1 && (fds[1].revents & (POLLOUT | POLLERR))) {
+                ssize_t n = write(writeFd, pending.data(), pending.size());
+                if (n < 0) {
+                    close(writeFd);
+                    writeFd = -1;
+                } else {
+                    pending.erase(0, n);
+                }
+            }
+        }
+
+        if (writeFd >= 0) close(writeFd);
+        close(fromChild[0]);
+        if (timedOut) kill(pid, SIGKILL);
+        int status = 0;
+        waitpid(pid, &status, 0);
+
+        double elapsed = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+        int expectedStatus = session.hasExpected ? session.expectedStatus : 0;
+        result.ok = !timedOut && WIFEXITED(status) && WEXITSTATUS(status) == expectedStatus;
+        result.latencyMs = max(0.0, elapsed - thinkMs);
+        result.outputHash = fnv64(output.data(), output.size());
+        return result;
+    }
+
+    // Open loop: sessions arrive as a Poisson process regardless of completions.
+    // A pool of maxInFlight workers runs them; an arrival that finds every
+    // worker busy is dropped rather than queued, so overload shows up as drops
+    // instead of hidden queueing delay.
+    void runOpenLoop(vector<ReplayResult>& results) const {
+        mutex lock;
+        condition_variable ready;
+        deque<pair<int, chrono::steady_clock::time_point>> arrivals;
+        int idle = options.maxInFlight;
+        bool done = false;
+
+        vector<thread> workers;
+        for (int w = 0; w < options.maxInFlight; w++) {
+            workers.emplace_back([&]() {
+                unique_lock<mutex> guard(lock);
+                while (true) {
+                    ready.wait(guard, [&]() { return !arrivals.empty() || done; });
+                    if (arrivals.empty()) return;
+                    auto arrival = arrivals.front();
+                    arrivals.pop_front();
+                    guard.unlock();
+                    double lag = chrono::duration<double, milli>(chrono::steady_clock::now() - arrival.second).count();
+                    results[arrival.first] = runSession();
+                    results[arrival.first].startLagMs = lag;
+                    guard.lock();
+                    idle++;
+                }
+            });
+        }
+
+        mt19937 rng(options.seed);
+        exponential_distribution<double> gap(options.rate);
+        auto start = chrono::steady_clock::now();
+        double arrival = 0;
+        for (int i = 0; i < options.sessions; i++) {
+            auto scheduled = start + chrono::duration_cast<chrono::steady_clock::duration>(
+                                         chrono::duration<double>(arrival));
+            this_thread::sleep_until(scheduled);
+            {
+                lock_guard<mutex> guard(lock);
+                if (idle == 0) {
+                    results[i].ran = false;
+                } else {
+                    idle--; // Reserved until the session finishes
+                    arrivals.push_back({i, scheduled});
+                    ready.notify_one();
+                }
+            }
+            arrival += gap(rng);
+        }
+        {
+            lock_guard<mutex> guard(lock);
+            done = true;
+        }
+        ready.notify_all();
+        for (auto& w : workers) w.join();
+    }
+
+    static double percentile(vector<double> sorted, double p) {
+        if (sorted.empty()) return 0;
+        size_t index = (size_t)ceil(p / 100.0 * sorted.size());
+        return sorted[min(sorted.size() - 1, index == 0 ? 0 : index - 1)];
+    }
+
+public:
+    SessionReplayer(const string& executable, const SessionLog& session, const ReplayOptions& options)
+        : executable(executable), session(session), options(options) {
+        // Replayed sessions skip the customer profile store (as recordings do):
+        // saved profiles would change the prompts between runs. The recording
+        // date is pinned so date-dependent prices match the recorded output.
+        for (char** e = environ; *e != NULL; e++) {
+            if (strncmp(*e, "WANDERPLAN_CUSTOMER_DB=", 23) != 0 && strncmp(*e, "WANDERPLAN_TODAY=", 17) != 0) {
+                environment.push_back(*e);
+            }
+        }
+        environment.push_back("WANDERPLAN_CUSTOMER_DB=");
+        if (!session.today.empty()) environment.push_back("WANDERPLAN_TODAY=" + session.today);
+        for (auto& entry : environment) envp.push_back(&entry[0]);
+        envp.push_back(NULL);
+    }
+
+    // Returns 0 when every session that ran succeeded with the expected output
+    int run() {
+        vector<ReplayResult> results(options.sessions, ReplayResult{true, false, 0, 0, 0});
+        auto start = chrono::steady_clock::now();
+
+        if (options.rate > 0) {
+            runOpenLoop(results);
+        } else {
+            // Closed loop: each user starts a new session as soon as the last one ends
+            vector<thread> workers;
+            atomic<int> nextSession(0);
+            for (int u = 0; u < options.users; u++) {
+                workers.emplace_back([this, &results, &nextSession]() {
+                    int i;
+                    while ((i = nextSession++) < options.sessions) results[i] = runSession();
+                });
+            }
+            for (auto& w : workers) w.join();
+        }
+        double elapsed = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+        // v2 logs are checked against the recording, v1 logs against the first session
+        bool haveReference = session.hasExpected;
+        unsigned long long reference = session.expectedHash;
+        int completed = 0, failures = 0, dropped = 0, late = 0, mismatches = 0;
+        double maxLag = 0;
+        vector<double> latencies;
+        for (auto& r : results) {
+            if (!r.ran) { dropped++; continue; }
+            completed++;
+            if (r.startLagMs > lateThresholdMs) late++;
+            maxLag = max(maxLag, r.startLagMs);
+            if (!r.ok) { failures++; continue; }
+            latencies.push_back(r.latencyMs);
+            if (!haveReference) {
+                haveReference = true;
+                reference = r.outputHash;
+            }
+            if (r.outputHash != reference) mismatches++;
+        }
+        sort(latencies.begin(), latencies.end());
+
+        cout << "\n====== REPLAY REPORT ======\n";
+        cout << "Mode: " << (options.rate > 0 ? "open loop" : "closed loop");
+        if (options.rate > 0) {
+            cout << " (" << options.rate << " sessions/s target, at most " << options.maxInFlight
+                 << " in flight)";
+        } else {
+            cout << " (" << options.users << " users)";
+        }
+        cout << "\nSessions: " << options.sessions << " (" << failures << " failed";
+        if (options.rate > 0) cout << ", " << dropped << " dropped";
+        cout << ")\n";
+        cout << fixed << setprecision(2);
+        if (options.rate > 0) {
+            cout << "Arrivals: " << late << " started over " << lateThresholdMs
+                 << " ms late (max lag " << maxLag << " ms)\n";
+        }
+        cout << "Elapsed: " << elapsed << " s\n";
+        cout << "Throughput: " << (elapsed > 0 ? completed / elapsed : 0) << " sessions/s\n";
+        cout << "Latency (ms): p50 " << percentile(latencies, 50) << ", p90 " << percentile(latencies, 90)
+             << ", p99 " << percentile(latencies, 99)
+             << ", max " << (latencies.empty() ? 0 : latencies.back()) << "\n";
+        cout << "Output hash: " << hex << reference << dec;
+        if (session.hasExpected) {
+            cout << (mismatches == 0 ? " (matches the recording)\n" : " (recorded)\n");
+            if (mismatches > 0) cout << mismatches << " sessions diverged from the recording\n";
+        } else {
+            cout << (mismatches == 0 ? " (deterministic)\n" : " (NON-DETERMINISTIC)\n");
+            if (mismatches > 0) cout << mismatches << " sessions produced different output\n";
+        }
+
+        return (failures == 0 && mismatches == 0) ? 0 : 1;
+    }
+};
+
+// --------------------- Catalog ---------------------
+void loadCatalog(PreferenceTree& preferences) {
+    // ========== NATIONAL DESTINATIONS (20) ==========
+    // 1. Jaipur
+    preferences.addDestination(
+        "Jaipur", "National", "INR", 5000, 8000,
+        {"Amber Fort", "Hawa Mahal", "City Palace", "Jantar Mantar", "Nahargarh Fort"},
+        {"Dal Baati Churma", "Laal Maas", "Ghewar", "Kachori", "Mawa Kachori"},
+        {"Day 1: Arrival & City Palace", "Day 2: Amber Fort and markets", "Day 3: Hawa Mahal and departure"},
+        {"Day 1: Heritage walk", "Day 2: Forts tour", "Day 3: Shopping and food trail"},
+        {"Day 1: Arrival & Jantar Mantar", "Day 2: Combined palace tour", "Day 3: Relax and departure"},
+        true, true, "Warm (15-30°C)", "Not required", "October-March"
+    );
+    preferences.setAttractionDetails("Jaipur", {
+        {"Amber Fort", 3.0, 1.5, 11.0},
+        {"Hawa Mahal", 1.0, 0.8, 0.5},
+        {"City Palace", 2.5, 0.4, 0.9},
+        {"Jantar Mantar", 1.5, 0.5, 0.7},
+        {"Nahargarh Fort", 2.5, -0.5, 6.0}
+    });
+    
+    // 2. Goa
+    preferences.addDestination(
+        "Goa", "National", "INR", 6000, 10000,
+        {"Beaches", "Dudhsagar Falls", "Old Goa Churches", "Fort Aguada", "Spice Plantations"},
+        {"Fish Curry Rice", "Bebinca", "Pork Vindaloo", "Feni", "Sorpotel"},
+        {"Day 1: North Goa beaches", "Day 2: Dudhsagar Falls", "Day 3: Old Goa sightseeing"},
+        {"Day 1: Beach hopping", "Day 2: Water sports", "Day 3: Relax and departure"},
+        {"Day 1: Arrival & local food", "Day 2: South Goa beaches", "Day 3: Sightseeing"},
+        true, true, "Humid (25-35°C)", "Not required", "November-February"
+    );
+
+    // 3-20. More national destinations
+    vector<string> nationalDests = {
+        "Kerala", "Shimla", "Manali", "Darjeeling", "Munnar", 
+        "Udaipur", "Varanasi", "Amritsar", "Rishikesh", "Agra",
+        "Mysore", "Puducherry", "Andaman", "Ooty", "Kodaikanal",
+        "Khajuraho", "Ajanta-Ellora", "Hampi", "Leh-Ladakh", "Kashmir"
+    };
+
+    vector<vector<string>> nationalAttractions = {
+        {"Backwaters", "Tea Gardens", "Alleppey Houseboat", "Kathakali Show"},
+        {"Mall Road", "Jakhu Temple", "Kufri", "Toy Train"},
+        {"Rohtang Pass", "Solang Valley", "Hadimba Temple", "Old Manali"},
+        {"Tiger Hill", "Batasia Loop", "Tea Gardens", "Himalayan Railway"},
+        {"Eravikulam Park", "Tea Museum", "Mattupetty Dam", "Echo Point"},
+        {"City Palace", "Lake Pichola", "Jag Mandir", "Sajjangarh"},
+        {"Ghats", "Kashi Vishwanath", "Sarnath", "Ganga Aarti"},
+        {"Golden Temple", "Jallianwala Bagh", "Wagah Border", "Partition Museum"},
+        {"River Rafting", "Beatles Ashram", "Laxman Jhula", "Ganga Aarti"},
+        {"Taj Mahal", "Agra Fort", "Fatehpur Sikri", "Mehtab Bagh"},
+        {"Mysore Palace", "Chamundi Hills", "Brindavan Gardens", "Zoo"},
+        {"Promenade Beach", "Auroville", "Paradise Beach", "French Quarter"},
+        {"Radhanagar Beach", "Cellular Jail", "Scuba Diving", "Limestone Caves"},
+        {"Botanical Gardens", "Ooty Lake", "Doddabetta Peak", "Tea Factory"},
+        {"Kodai Lake", "Pillar Rocks", "Coaker's Walk", "Bryant Park"},
+        {"Khajuraho Temples", "Light & Sound Show", "Panna National Park"},
+        {"Ajanta Caves", "Ellora Caves", "Bibi Ka Maqbara", "Grishneshwar Temple"},
+        {"Virupaksha Temple", "Vittala Temple", "Elephant Stables", "Lotus Mahal"},
+        {"Pangong Lake", "Nubra Valley", "Magnetic Hill", "Leh Palace"},
+        {"Dal Lake", "Gulmarg", "Pahalgam", "Shalimar Garden"}
+    };
+
+    for(int i=0; i<nationalDests.size(); i++){
+        preferences.addDestination(
+            nationalDests[i], "National", "INR", 
+            4000 + (i*1000), 8000 + (i*1500),
+            nationalAttractions[i],
+            {"Local Cuisine 1", "Local Cuisine 2", "Special Dessert"},
+            {"Day 1: Arrival", "Day 2: Sightseeing", "Day 3: Departure"},
+            {"Day 1: Relax", "Day 2: Adventure", "Day 3: Culture"},
+            {"Day 1: Food Tour", "Day 2: Full day tour", "Day 3: Shopping"},
+            true, true, "Varies", "Not required", "Varies"
+        );
+    }
+
+    // ========== INTERNATIONAL DESTINATIONS (20) ==========
+    // 1. Vietnam
+    preferences.addDestination(
+        "Vietnam", "International", "VND", 30000, 50000,
+        {"Ha Long Bay", "Hoi An", "Hanoi Old Quarter", "Cu Chi Tunnels", "Mekong Delta"},
+        {"Pho", "Banh Mi", "Bun Cha", "Goi Cuon", "Cao Lau"},
+        {"Day 1: Hanoi arrival", "Day 2: Ha Long cruise", "Day 3: Hoi An"},
+        {"Day 1: Food tour", "Day 2: Cu Chi Tunnels", "Day 3: Mekong"},
+        {"Day 1: City tour", "Day 2: Countryside", "Day 3: Relax"},
+        true, true, "Tropical (20-35°C)", "Visa required", "November-April"
+    );
+
+    // 2-20. More international destinations
+    vector<string> intlDests = {
+        "Bali", "Thailand", "Singapore", "Malaysia", "Dubai",
+        "Turkey", "Japan", "South Korea", "France", "Italy",
+        "Switzerland", "Spain", "Greece", "Portugal", "Australia",
+        "New Zealand", "Maldives", "Sri Lanka", "Nepal", "Bhutan"
+    };
+
+    vector<vector<string>> intlAttractions = {
+        {"Ubud", "Tanah Lot", "Uluwatu", "Tegallalang"},
+        {"Bangkok", "Phuket", "Chiang Mai", "Phi Phi Islands"},
+        {"Marina Bay", "Sentosa", "Gardens by the Bay", "Universal Studios"},
+        {"Kuala Lumpur", "Langkawi", "Penang", "Cameron Highlands"},
+        {"Burj Khalifa", "Palm Jumeirah", "Desert Safari", "Dubai Mall"},
+        {"Hagia Sophia", "Cappadocia", "Pamukkale", "Ephesus"},
+        {"Tokyo", "Kyoto", "Osaka", "Mount Fuji"},
+        {"Seoul", "Busan", "Jeju Island", "DMZ"},
+        {"Paris", "Nice", "Lyon", "French Riviera"},
+        {"Rome", "Venice", "Florence", "Amalfi Coast"},
+        {"Zurich", "Interlaken", "Lucerne", "Jungfraujoch"},
+        {"Barcelona", "Madrid", "Seville", "Ibiza"},
+        {"Athens", "Santorini", "Mykonos", "Crete"},
+        {"Lisbon", "Porto", "Algarve", "Madeira"},
+        {"Sydney", "Melbourne", "Great Barrier Reef", "Gold Coast"},
+        {"Auckland", "Queenstown", "Rotorua", "Milford Sound"},
+        {"Male", "Private Islands", "Underwater Restaurant"},
+        {"Colombo", "Kandy", "Galle", "Sigiriya"},
+        {"Kathmandu", "Pokhara", "Everest Base Camp", "Chitwan"},
+        {"Paro", "Thimphu", "Punakha", "Tiger's Nest"}
+    };
+
+    vector<string> intlCurrencies = {
+        "IDR", "THB", "SGD", "MYR", "AED",
+        "TRY", "JPY", "KRW", "EUR", "EUR",
+        "CHF", "EUR", "EUR", "EUR", "AUD",
+        "NZD", "USD", "LKR", "NPR", "BTN"
+    };
+
+    for(int i=0; i<intlDests.size(); i++){
+        preferences.addDestination(
+            intlDests[i], "International", intlCurrencies[i],
+            30000 + (i*5000), 60000 + (i*8000),
+            intlAttractions[i],
+            {"Local Specialty 1", "Local Specialty 2", "Famous Dish"},
+            {"Day 1: Arrival", "Day 2: Main Attraction", "Day 3: Culture"},
+            {"Day 1: Relax", "Day 2: Adventure", "Day 3: Food Tour"},
+            {"Day 1: City Tour", "Day 2: Full day tour", "Day 3: Shopping"},
+            true, true, "Varies", "Visa info varies", "Best season varies"
+        );
+    }
+}
+
+// --------------------- Query Stress Test ---------------------
+// Runs budget-band, keyword and name queries against one shared catalog from
+// several threads and checks every answer against a single-threaded pass.
+// Built with -fsanitize=thread it checks the const query API for data races.
+bool sameKeywordMatches(const vector<KeywordMatch>& a, const vector<KeywordMatch>& b) {
+    if (a.size() != b.size()) return false;
+    for (size_t i = 0; i < a.size(); i++) {
+        if (a[i].id != b[i].id || a[i].score != b[i].score || a[i].termsMatched != b[i].termsMatched) return false;
+    }
+    return true;
+}
+
+int runQueryStress(int numThreads, int iterations) {
+    PreferenceTree catalog;
+    loadCatalog(catalog);
+
+    static const char* purposes[4] = {"family", "couple", "friends", "solo"};
+    static const char* keywords[6] = {"temple", "Temple OR beach", "fort palace", "tea gardens",
+                                      "island or lake", "or beach"};
+    vector<BudgetQuery> budgetQueries;
+    vector<KeywordQuery> keywordQueries;
+    for (const char* purpose : purposes) {
+        for (string type : {"National", "International"}) {
+            for (auto& band : PreferenceTree::budgetBands(type)) {
+                budgetQueries.push_back({type, band.minRange, band.maxRange, purpose, 2, 1, -1});
+            }
+        }
+        for (const char* text : keywords) {
+            KeywordQuery query = KeywordQuery::parse(text);
+            query.tripPurpose = purpose;
+            query.adults = 2;
+            keywordQueries.push_back(query);
+        }
+    }
+
+    // Expected answers from a single-threaded pass
+    vector<vector<const Destination*>> expectedBudget(budgetQueries.size());
+    vector<vector<KeywordMatch>> expectedKeyword(keywordQueries.size());
+    for (size_t i = 0; i < budgetQueries.size(); i++) catalog.findByBudgetRange(budgetQueries[i], expectedBudget[i]);
+    for (size_t i = 0; i < keywordQueries.size(); i++) catalog.searchByKeywords(keywordQueries[i], expectedKeyword[i]);
+
+    size_t kinds = budgetQueries.size() + keywordQueries.size() + catalog.size();
+    atomic<long long> mismatches(0);
+    auto start = chrono::steady_clock::now();
+    vector<thread> workers;
+    for (int t = 0; t < numThreads; t++) {
+        workers.emplace_back([&, t]() {
+            // Caller-owned buffers, reused across queries
+            vector<const Destination*> found;
+            vector<KeywordMatch> matches;
+            for (int i = 0; i < iterations; i++) {
+                size_t k = ((size_t)t * 7919 + (size_t)i * 104729) % kinds;
+                bool ok;
+                if (k < budgetQueries.size()) {
+                    catalog.findByBudgetRange(budgetQueries[k], found);
+                    ok = found == expectedBudget[k];
+                } else if ((k -= budgetQueries.size()) < keywordQueries.size()) {
+                    catalog.searchByKeywords(keywordQueries[k], matches);
+                    ok = sameKeywordMatches(matches, expectedKeyword[k]);
+                } else {
+                    k -= keywordQueries.size();
+                    const Destination* dest = catalog.getDestinationById(k);
+                    ok = dest != NULL && catalog.getDestinationByName(dest->name) == dest;
+                }
+                if (!ok) mismatches++;
+            }
+        });
+    }
+    for (auto& w : workers) w.join();
+    double elapsed = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    long long total = (long long)numThreads * iterations;
+    cout << "\n====== QUERY STRESS TEST ======\n";
+    cout << numThreads << " threads x " << iterations << " queries over one shared catalog\n";
+    cout << fixed << setprecision(0) << "Throughput: " << total / elapsed << " queries/s\n";
+    cout << "Mismatches: " << mismatches.load() << "\n";
+    return mismatches == 0 ? 0 : 1;
+}
+
+// --------------------- Catalog Sharding ---------------------
+// Splits the catalog across worker processes. Each worker loads only its
+// shard's destinations (PreferenceTree::setShard) and serves budget-band,
+// keyword and quote queries over a pair of single-producer/single-consumer
+// rings in shared memory. The coordinator scatters every request to all
+// shards, keeps a window of requests in flight, and merges each request's
+// partial top-K lists once every shard has answered. Idle workers and the
+// waiting coordinator sleep on futex doorbells instead of spinning.
+enum ShardQueryKind { QUERY_BUDGET, QUERY_KEYWORD, QUERY_QUOTE, QUERY_SHUTDOWN };
+
+struct ShardRequest {
+    uint32_t id;
+    uint32_t kind;
+    char tripType[16];
+    char tripPurpose[12];
+    int32_t adults, children, nights, topK;
+    int32_t travelDay;         // -1 for year-round prices
+    double minRange, maxRange; // Budget band (QUERY_BUDGET)
+    char text[96];             // Keywords (QUERY_KEYWORD) or destination (QUERY_QUOTE)
+};
+
+struct ShardEntry {
+    char name[32];
+    double score;              // Higher ranks first
+    double cost;               // Party cost in INR
+};
+
+static const int maxShardTopK = 8;
+
+struct ShardResponse {
+    uint32_t id;
+    uint32_t count;
+    uint32_t missingShards;    // Shards that died before answering (merged results only)
+    ShardEntry entries[maxShardTopK];
+};
+
+// A futex word in shared memory. A waiter reads seq, checks its ring, and
+// sleeps only while seq is unchanged, so a ring() after the check is never lost.
+struct Doorbell {
+    atomic<uint32_t> seq;
+    atomic<uint32_t> sleepers;
+
+    void ring() {
+        seq.fetch_add(1);
+        if (sleepers.load() > 0) {
+            syscall(SYS_futex, (uint32_t*)&seq, FUTEX_WAKE, INT_MAX, NULL, NULL, 0);
+        }
+    }
+
+    // Returns after a ring() since `seen` was read, or after timeoutMs
+    void wait(uint32_t seen, int timeoutMs) {
+        timespec timeout = {timeoutMs / 1000, (timeoutMs % 1000) * 1000000L};
+        sleepers.fetch_add(1);
+        if (seq.load() == seen) {
+            syscall(SYS_futex, (uint32_t*)&seq, FUTEX_WAIT, seen, &timeout, NULL, 0);
+        }
+        sleepers.fetch_sub(1);
+    }
+};
+
+template <typename T, uint64_t Capacity>
+struct SpscRing {
+    alignas(64) atomic<uint64_t> head; // Next slot to read
+    alignas(64) atomic<uint64_t> tail; // Next slot to write
+    alignas(64) T slots[Capacity];
+
+    bool full() const {
+        return tail.load(memory_order_relaxed) - head.load(memory_order_acquire) == Capacity;
+    }
+
+    bool push(const T& item) {
+        uint64_t t = tail.load(memory_order_relaxed);
+        if (t - head.load(memory_order_acquire) == Capacity) return false;
+        slots[t % Capacity] = item;
+        tail.store(t + 1, memory_order_release);
+        return true;
+    }
+
+    bool pop(T& item) {
+        uint64_t h = head.load(memory_order_relaxed);
+        if (h == tail.load(memory_order_acquire)) return false;
+        item = slots[h % Capacity];
+        head.store(h + 1, memory_order_release);
+        return true;
+    }
+};
+
+struct ShardChannel {
+    SpscRing<ShardRequest, 64> requests;
+    SpscRing<ShardResponse, 64> responses;
+    Doorbell requestBell;      // Rung by the coordinator after each push
+};
+
+// Shared mapping layout: one doorbell the workers ring after every response,
+// followed by a channel per shard
+struct ShardMapping {
+    Doorbell responseBell;
+    alignas(64) ShardChannel channels[1];
+};
+
+struct CatalogShard {
+    PreferenceTree tree;
+    Transport transport;
+    HotelAccommodation hotels;
+
+    // Call after tree.setShard(); prices follow the loaded destinations' seasons
+    void load() {
+        loadCatalog(tree);
+        transport.loadSeasonalFares(tree);
+        hotels.loadSeasonalRates(tree);
+    }
+};
+
+bool shardEntryBefore(const ShardEntry& a, const ShardEntry& b) {
+    if (a.score != b.score) return a.score > b.score;
+    return strcmp(a.name, b.name) < 0;
+}
+
+void keepTopK(vector<ShardEntry>& entries, int topK, ShardResponse& out) {
+    out.missingShards = 0;
+    sort(entries.begin(), entries.end(), shardEntryBefore);
+    out.count = min<size_t>(entries.size(), min(topK, maxShardTopK));
+    for (uint32_t i = 0; i < out.count; i++) out.entries[i] = entries[i];
+}
+
+ShardEntry makeShardEntry(const string& name, double score, double cost) {
+    ShardEntry entry;
+    memset(entry.name, 0, sizeof(entry.name));
+    strncpy(entry.name, name.c_str(), sizeof(entry.name) - 1);
+    entry.score = score;
+    entry.cost = cost;
+    return entry;
+}
+
+// Answers one request from a single shard's catalog
+void answerShardQuery(const CatalogShard& shard, const ShardRequest& request, ShardResponse& out) {
+    out.id = request.id;
+    out.count = 0;
+    vector<ShardEntry> entries;
+    double minTotal, maxTotal;
+
+    if (request.kind == QUERY_BUDGET) {
+        vector<const Destination*> found;
+        shard.tree.findByBudgetRange({request.tripType, request.minRange, request.maxRange,
+                                      request.tripPurpose, request.adults, request.children, request.travelDay},
+                                     found);
+        for (auto dest : found) {
+            PreferenceTree::partyCostRange(dest, request.adults, request.children, request.travelDay,
+                                           minTotal, maxTotal);
+            entries.push_back(makeShardEntry(dest->name, -minTotal, minTotal)); // Cheapest first
+        }
+    } else if (request.kind == QUERY_KEYWORD) {
+        vector<KeywordMatch> matches;
+        KeywordQuery query = KeywordQuery::parse(request.text);
+        query.tripType = request.tripType;
+        query.tripPurpose = request.tripPurpose;
+        query.adults = request.adults;
+        query.children = request.children;
+        query.travelDay = request.travelDay;
+        shard.tree.searchByKeywords(query, matches);
+        for (auto& match : matches) {
+            const Destination* dest = shard.tree.getDestinationById(match.id);
+            PreferenceTree::partyCostRange(dest, request.adults, request.children, request.travelDay,
+                                           minTotal, maxTotal);
+            entries.push_back(makeShardEntry(dest->name, match.termsMatched * 10000.0 + match.score, minTotal));
+        }
+    } else if (request.kind == QUERY_QUOTE) {
+        // Only the shard that owns the destination can quote it
+        const Destination* dest = shard.tree.getDestinationByName(request.text);
+        if (dest != NULL) {
+            PreferenceTree::partyCostRange(dest, request.adults, request.children, request.travelDay,
+                                           minTotal, maxTotal);
+            double fare = 0;
+            for (auto& option : shard.transport.getOptions(dest->name)) {
+                double adultFare = shard.transport.fareOn(dest->name, option.second, request.travelDay);
+                if (fare == 0 || adultFare < fare) fare = adultFare;
+            }
+            double rate = shard.hotels.cheapestNightlyRate(dest->name);
+            double hotel = rate < 0 ? 0 : shard.hotels.stayCost(dest->name, rate, request.travelDay, request.nights,
+                                                                request.adults + request.children);
+            double total = minTotal + fare * request.adults + fare * 0.7 * request.children + hotel;
+            entries.push_back(makeShardEntry(dest->name, -total, total));
+        }
+    }
+    keepTopK(entries, request.topK, out);
+}
+
+void runShardWorker(ShardMapping* mapping, int index, int count, ShardKey key) {
+    CatalogShard shard;
+    shard.tree.setShard(index, count, key);
+    shard.load();
+
+    ShardChannel& channel = mapping->channels[index];
+    ShardRequest request;
+    ShardResponse response;
+    while (true) {
+        uint32_t seen = channel.requestBell.seq.load();
+        if (!channel.requests.pop(request)) {
+            channel.requestBell.wait(seen, 1000);
+            continue;
+        }
+        if (request.kind == QUERY_SHUTDOWN) break;
+        answerShardQuery(shard, request, response);
+        // The coordinator never has more requests in flight than the ring holds
+        while (!channel.responses.push(response)) this_thread::yield();
+        mapping->responseBell.ring();
+    }
+}
+
+class ShardCoordinator {
+private:
+    int count;
+    ShardMapping* mapping;
+    size_t mapSize;
+    vector<pid_t> workers;   // -1 once a worker has been reaped
+    int lost;                // Workers that exited before shutdown
+
+    // Reaps workers that have exited; returns true if any had not been seen dead
+    bool reapDeadWorkers() {
+        bool found = false;
+        for (size_t i = 0; i < workers.size(); i++) {
+            if (workers[i] > 0 && waitpid(workers[i], NULL, WNOHANG) == workers[i]) {
+                workers[i] = -1;
+                lost++;
+                found = true;
+            }
+        }
+        return found;
+    }
+
+public:
+    ShardCoordinator() : count(0), mapping(NULL), mapSize(0), lost(0) {}
+    ~ShardCoordinator() { stop(); }
+
+    bool start(int shardCount, ShardKey key) {
+        stop();
+        count = max(1, shardCount);
+        mapSize = sizeof(ShardMapping) + sizeof(ShardChannel) * (count - 1);
+        void* mem = mmap(NULL, mapSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+        if (mem == MAP_FAILED) return false;
+        mapping = (ShardMapping*)mem;
+        mapping->responseBell.seq = mapping->responseBell.sleepers = 0;
+        for (int i = 0; i < count; i++) {
+            ShardChannel* channel = new (&mapping->channels[i]) ShardChannel();
+            channel->requests.head = channel->requests.tail = 0;
+            channel->responses.head = channel->responses.tail = 0;
+            channel->requestBell.seq = channel->requestBell.sleepers = 0;
+        }
+        lost = 0;
+        pid_t parent = getpid();
+        cout.flush();
+        for (int i = 0; i < count; i++) {
+            pid_t pid = fork();
+            if (pid == 0) {
+                // Don't outlive the coordinator
+                prctl(PR_SET_PDEATHSIG, SIGKILL);
+                if (getppid() != parent) _exit(1);
+                runShardWorker(mapping, i, count, key);
+                _exit(0);
+            }
+            if (pid < 0) {
+                stop();
+                return false;
+            }
+            workers.push_back(pid);
+        }
+        return true;
+    }
+
+    // Asks live workers to exit and waits up to two seconds before killing them
+    void stop() {
+        if (mapping == NULL) return;
+        ShardRequest shutdown = {};
+        shutdown.kind = QUERY_SHUTDOWN;
+        for (size_t i = 0; i < workers.size(); i++) {
+            if (workers[i] > 0 && mapping->channels[i].requests.push(shutdown)) {
+                mapping->channels[i].requestBell.ring();
+            }
+        }
+        auto deadline = chrono::steady_clock::now() + chrono::seconds(2);
+        for (pid_t& pid : workers) {
+            while (pid > 0 && waitpid(pid, NULL, WNOHANG) == 0) {
+                if (chrono::steady_clock::now() >= deadline) {
+                    kill(pid, SIGKILL);
+                    waitpid(pid, NULL, 0);
+                    break;
+                }
+                this_thread::sleep_for(chrono::milliseconds(5));
+            }
+            pid = -1;
+        }
+        workers.clear();
+        munmap(mapping, mapSize);
+        mapping = NULL;
+    }
+
+    // Workers that have died since start()
+    int lostShards() const { return lost; }
+
+    // Runs a batch with up to `window` requests in flight; results[i] answers requests[i].
+    // A shard that dies is dropped: requests it had not answered complete with
+    // missingShards set, and later requests skip it. Returns false if any shard
+    // was missing from any result.
+    bool runBatch(const vector<ShardRequest>& requests, vector<ShardResponse>& results, int window = 32) {
+        size_t total = requests.size();
+        results.assign(total, ShardResponse());
+        vector<vector<ShardEntry>> partial(total);
+        vector<int> pending(total, 0);
+        vector<uint32_t> missing(total, 0);
+        // Shards answer in request order, so answered[i] is the next request id shard i owes
+        vector<size_t> answered(count, 0);
+        vector<bool> dropped(count);
+        for (int i = 0; i < count; i++) dropped[i] = workers[i] < 0;
+        size_t issued = 0, completed = 0;
+        bool complete = true;
+        window = min(window, 64);
+
+        auto finish = [&](size_t id) {
+            results[id].id = id;
+            keepTopK(partial[id], requests[id].topK, results[id]);
+            results[id].missingShards = missing[id];
+            complete = complete && missing[id] == 0;
+            completed++;
+        };
+
+        while (completed < total) {
+            // Scatter the next request once every live shard has room for it
+            while (issued < total && issued - completed < (size_t)window) {
+                bool room = true;
+                for (int i = 0; i < count; i++) {
+                    room = room && (dropped[i] || !mapping->channels[i].requests.full());
+                }
+                if (!room) break;
+                ShardRequest request = requests[issued];
+                request.id = issued;
+                for (int i = 0; i < count; i++) {
+                    if (dropped[i]) {
+                        missing[issued]++;
+                        continue;
+                    }
+                    mapping->channels[i].requests.push(request);
+                    mapping->channels[i].requestBell.ring();
+                    pending[issued]++;
+                }
+                if (pending[issued] == 0) finish(issued);
+                issued++;
+            }
+
+            uint32_t seen = mapping->responseBell.seq.load();
+            bool progress = false;
+            ShardResponse response;
+            for (int i = 0; i < count; i++) {
+                while (mapping->channels[i].responses.pop(response)) {
+                    progress = true;
+                    answered[i] = response.id + 1;
+                    vector<ShardEntry>& entries = partial[response.id];
+                    entries.insert(entries.end(), response.entries, response.entries + response.count);
+                    if (--pending[response.id] == 0) finish(response.id);
+                }
+            }
+            if (progress) continue;
+
+            if (reapDeadWorkers()) {
+                for (int i = 0; i < count; i++) {
+                    if (workers[i] >= 0 || dropped[i]) continue;
+                    dropped[i] = true;
+                    // Drain anything it answered before dying, then write off the rest
+                    while (mapping->channels[i].responses.pop(response)) {
+                        answered[i] = response.id + 1;
+                        vector<ShardEntry>& entries = partial[response.id];
+                        entries.insert(entries.end(), response.entries, response.entries + response.count);
+                        if (--pending[response.id] == 0) finish(response.id);
+                    }
+                    for (size_t id = answered[i]; id < issued; id++) {
+                        missing[id]++;
+                        if (--pending[id] == 0) finish(id);
+                    }
+                }
+                continue;
+            }
+            mapping->responseBell.wait(seen, 50);
+        }
+        return complete;
+    }
+};
+
+// Deterministic mix of budget-band, keyword and quote requests
+vector<ShardRequest> makeShardWorkload(int total) {
+    static const char* purposes[4] = {"family", "couple", "friends", "solo"};
+    static const char* keywords[6] = {"temple", "beach or lake", "tea gardens", "fort palace",
+                                      "temple or beach", "island"};
+    static const char* quoteTargets[6] = {"Jaipur", "Goa", "Vietnam", "Bali", "Kerala", "Turkey"};
+    vector<ShardRequest> requests;
+    int today = todayDayNumber();
+    for (int i = 0; i < total; i++) {
+        ShardRequest request = {};
+        request.travelDay = (i % 4 == 0) ? -1 : today + (i * 7) % 180;
+        request.adults = 1 + i % 3;
+        request.children = i % 2;
+        request.nights = 2 + i % 5;
+        request.topK = 5;
+        strncpy(request.tripPurpose, purposes[i % 4], sizeof(request.tripPurpose) - 1);
+        const char* type = (i / 3) % 2 ? "International" : "National";
+        switch (i % 3) {
+            case 0: {
+                request.kind = QUERY_BUDGET;
+                strncpy(request.tripType, type, sizeof(request.tripType) - 1);
+                BudgetBand band = PreferenceTree::budgetBands(type)[(i / 6) % 3];
+                request.minRange = band.minRange;
+                request.maxRange = band.maxRange;
+                break;
+            }
+            case 1:
+                request.kind = QUERY_KEYWORD;
+                strncpy(request.text, keywords[(i / 3) % 6], sizeof(request.text) - 1);
+                break;
+            default:
+                request.kind = QUERY_QUOTE;
+                strncpy(request.text, quoteTargets[(i / 3) % 6], sizeof(request.text) - 1);
+                break;
+        }
+        requests.push_back(request);
+    }
+    return requests;
+}
+
+bool sameShardResults(const ShardResponse& a, const ShardResponse& b) {
+    if (a.count != b.count) return false;
+    for (uint32_t i = 0; i < a.count; i++) {
+        if (strcmp(a.entries[i].name, b.entries[i].name) != 0 || a.entries[i].cost != b.entries[i].cost) return false;
+    }
+    return true;
+}
+
+// Checks sharded answers against a single in-process catalog and reports
+// throughput for 1, 2, 4, ... up to maxShards worker processes
+int runShardBenchmark(int maxShards, ShardKey key, int totalRequests) {
+    vector<ShardRequest> requests = makeShardWorkload(totalRequests);
+
+    CatalogShard reference;
+    reference.load();
+    vector<ShardResponse> expected(requests.size());
+    auto start = chrono::steady_clock::now();
+    for (size_t i = 0; i < requests.size(); i++) {
+        answerShardQuery(reference, requests[i], expected[i]);
+    }
+    double baseline = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    cout << "\n====== SHARD BENCHMARK ======\n";
+    cout << totalRequests << " requests, sharded by " << (key == SHARD_BY_TYPE ? "type" : "hash")
+         << ", " << thread::hardware_concurrency() << " hardware threads\n";
+    cout << fixed << setprecision(0);
+    cout << "In-process (no IPC): " << requests.size() / baseline << " req/s\n\n";
+    cout << "Shards  Req/s       Speedup  Verified\n";
+
+    vector<int> shardCounts;
+    for (int n = 1; n < maxShards; n *= 2) shardCounts.push_back(n);
+    shardCounts.push_back(maxShards);
+
+    bool allVerified = true;
+    double oneShardRate = 0;
+    for (int shards : shardCounts) {
+        ShardCoordinator coordinator;
+        if (!coordinator.start(shards, key)) {
+            cout << shards << "       failed to start workers\n";
+            return 1;
+        }
+        // Warm-up: workers build their catalogs before the clock starts
+        vector<ShardResponse> results;
+        coordinator.runBatch(vector<ShardRequest>(requests.begin(), requests.begin() + min<size_t>(64, requests.size())),
+                             results);
+        start = chrono::steady_clock::now();
+        bool complete = coordinator.runBatch(requests, results);
+        double elapsed = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        int lost = coordinator.lostShards();
+        coordinator.stop();
+        if (!complete || lost > 0) {
+            cout << left << setw(8) << shards << right << lost << " shard worker(s) died; results incomplete\n";
+            allVerified = false;
+            continue;
+        }
+
+        bool verified = true;
+        for (size_t i = 0; i < requests.size(); i++) verified = verified && sameShardResults(results[i], expected[i]);
+        allVerified = allVerified && verified;
+        double rate = requests.size() / elapsed;
+        if (shards == 1) oneShardRate = rate;
+        cout << left << setw(8) << shards << setw(12) << rate << setprecision(2) << setw(9)
+             << rate / oneShardRate << setprecision(0) << (verified ? "yes" : "NO") << right << "\n";
+    }
+    return allVerified ? 0 : 1;
+}
+
+// --------------------- Main Function ---------------------
+int runPlanner() {
+    cout << "====== SMART WANDERPLAN - COMPREHENSIVE TRAVEL PLANNER ======\n";
+    
+    // Profiles live in the user's home directory by default. WANDERPLAN_CUSTOMER_DB
+    // overrides the file; set it empty to disable
+    const char* dbPath = getenv("WANDERPLAN_CUSTOMER_DB");
+    const char* home = getenv("HOME");
+    string customerDb = dbPath ? dbPath
+                      : (home != NULL && *home) ? string(home) + "/.wanderplan_customers.db"
+                      : "wanderplan_customers.db";
+    CustomerStore customerStore;
+    if (!customerDb.empty() && !customerStore.open(customerDb)) {
+        cout << "(Customer profiles unavailable: cannot open " << customerDb << ")\n";
+    }
+    
+    while (true) {
+        CustomerDetails customer;
+        if (!customer.inputDetails(customerStore.isOpen() ? &customerStore : nullptr)) {
+            if (!cin) break; // Input closed
+            cout << "Restarting input...\n";
+            continue;
+        }
+        customer.displayDetails();
+        customerStore.recordVisit(customer.number, customer.name, customer.email,
+                                  customer.adults, customer.children, customer.tripPurpose);
+
+        PreferenceTree preferences;
+        loadCatalog(preferences);
+        Transport transport;
+        transport.loadSeasonalFares(preferences);
+        HotelAccommodation hotels;
+        hotels.loadSeasonalRates(preferences);
+        
+        // ========== TRIP PLANNING FLOW ==========
+        cout << "\nSelect trip type:\n1. National\n2. International\n3. Search by keywords\n"
+             << "4. Multi-city tour\n";
+        string tripTypeChoice;
+        getline(cin, tripTypeChoice);
+        
+        cout << "Travel date (YYYY-MM-DD, press Enter to skip): ";
+        string dateInput;
+        getline(cin, dateInput);
+        int travelDay = dateInput.empty() ? -1 : parseDate(dateInput);
+        if (!dateInput.empty() && travelDay < 0) {
+            cout << "Invalid date, showing year-round prices.\n";
+        }
+        
+        if (tripTypeChoice == "4") {
+            TourPlanner planner(transport, hotels);
+            planner.planTour(preferences, customer.adults, customer.children, travelDay);
+            
+            cout << "\nBook another trip? (y/n): ";
+            string restartChoice;
+            getline(cin, restartChoice);
+            if (toLower(restartChoice) != "y") break;
+            continue;
+        }
+        
+        const Destination* selectedDest = nullptr;
+        if (tripTypeChoice == "3") {
+            selectedDest = preferences.selectDestinationByKeywords(
+                customer.tripPurpose, customer.adults, customer.children, travelDay);
+        } else {
+            string tripType = (tripTypeChoice == "1") ? "National" : "International";
+            
+            preferences.showBudgetRanges(tripType, customer.tripPurpose, customer.adults, customer.children,
+                                         travelDay);
+            
+            cout << "\nSelect budget range (1-3): ";
+            string rangeChoice;
+            getline(cin, rangeChoice);
+            int range = 0; // Anything unparsable falls through to "Invalid selection"
+            try {
+                range = stoi(rangeChoice);
+            } catch (...) {}
+            
+            selectedDest = preferences.selectDestinationFromRange(
+                tripType, customer.tripPurpose, customer.adults, customer.children, range, travelDay);
+        }
+        
+        if (!selectedDest) {
+            if (!cin) break;
+            cout << "Invalid selection. Restarting...\n";
+            continue;
+        }
+        
+        preferences.showDestinationDetails(selectedDest, customer.adults, customer.children, travelDay);
+        
+        transport.showTransportOptions(selectedDest->name, customer.adults, customer.children, travelDay);
+        
+        int nights = 0;
+        while (true) {
+            cout << "\nEnter number of nights for stay: ";
+            string nightsInput;
+            if (!getline(cin, nightsInput)) break;
+            try {
+                nights = stoi(nightsInput);
+                if (nights < 1) throw invalid_argument("");
+                break;
+            } catch (...) {
+                cout << "Please enter at least 1 night.\n";
+            }
+        }
+        if (!cin) break; // Input closed
+        hotels.showHotelOptions(selectedDest->name, customer.adults, customer.children, nights, travelDay);
+        
+        cout << "\nFind the cheapest " << nights << "-night window in the next 90 days? (y/n): ";
+        string windowChoice;
+        getline(cin, windowChoice);
+        if (toLower(windowChoice) == "y") {
+            TravelWindow window = findCheapestWindow(selectedDest, transport, hotels, customer.adults,
+                                                     customer.children, nights, todayDayNumber(), 90);
+            if (window.startDay < 0) {
+                cout << "Seasonal pricing is not available for " << selectedDest->name << ".\n";
+            } else {
+                cout << "\nCheapest window: " << formatDate(window.startDay) << " to "
+                     << formatDate(window.startDay + nights) << "\n" << fixed << setprecision(0)
+                     << "Package: " << window.packageCost << " INR\n"
+                     << "Transport (" << window.transportMode << "): " << window.transportCost << " INR\n"
+                     << "Hotel: " << window.hotelCost << " INR\n"
+                     << "Total: " << window.total << " INR\n";
+            }
+        }
+        
+        // Without surveyed locations the fixed itinerary options shown above stand
+        if (!selectedDest->attractionDetails.empty()) {
+            cout << "\nGenerate a day-by-day itinerary for your stay? (y/n): ";
+            string itineraryChoice;
+            getline(cin, itineraryChoice);
+            if (toLower(itineraryChoice) == "y") {
+                ItineraryGenerator generator;
+                Itinerary plan = generator.generate(selectedDest->attractionDetails, nights);
+                ItineraryGenerator::printItinerary(plan, selectedDest->attractionDetails, selectedDest->name);
+            }
+        }
+        
+        cout << "\nForecast cost risk? Enter your total budget in INR (or press Enter to skip): ";
+        string riskInput;
+        getline(cin, riskInput);
+        if (!riskInput.empty()) {
+            double budget = 0;
+            try {
+                budget = stod(riskInput);
+            } catch (...) {
+                cout << "Invalid budget, forecasting without a budget check.\n";
+            }
+            TripPackage trip;
+            PreferenceTree::partyCostRange(selectedDest, customer.adults, customer.children, travelDay,
+                                           trip.packageMin, trip.packageMax);
+            trip.adultFare = 0;
+            for (auto& option : transport.getOptions(selectedDest->name)) {
+                double fare = transport.fareOn(selectedDest->name, option.second, travelDay);
+                if (trip.adultFare == 0 || fare < trip.adultFare) trip.adultFare = fare;
+            }
+            // Average rate over the stay, so weekend and seasonal nights are weighted in
+            double baseRate = hotels.cheapestNightlyRate(selectedDest->name);
+            trip.nightlyRate = (baseRate < 0) ? 0 :
+                hotels.stayCost(selectedDest->name, baseRate, travelDay, nights, 2) / nights;
+            trip.adults = customer.adults;
+            trip.children = customer.children;
+            trip.nights = nights;
+            trip.currency = selectedDest->currency;
+            CostRiskForecaster forecaster;
+            CostRiskForecaster::printForecast(forecaster.forecast(trip, budget, 1000000), budget);
+        }
+        
+        cout << "\n====== TRIP SUMMARY ======\n";
+        cout << "Destination: " << selectedDest->name << "\nTravelers: " 
+             << customer.adults << " adults, " << customer.children << " children\n";
+        
+        cout << "\nBook another trip? (y/n): ";
+        string restartChoice;
+        getline(cin, restartChoice);
+        if (toLower(restartChoice) != "y") break;
+    }
+    
+    cout << "\nThank you for using Smart WanderPlan!\n";
+    // Input closing mid-session (e.g. a replay whose lines ran out at the
+    // wrong prompts) is a failure
+    return cin ? 0 : 1;
+}
+
+void printUsage(const char* program) {
+    cout << "Usage:\n"
+         << "  " << program << "                      Interactive planner\n"
+         << "  " << program << " --record <log>       Interactive planner, recording inputs to <log>\n"
+         << "  " << program << " --replay <log> [--users N] [--sessions N] [--rate R]\n"
+         << "        [--max-inflight N] [--think-scale F] [--timeout S] [--seed N]\n"
+         << "                                   Replay <log> against the planner. --rate selects\n"
+         << "                                   open-loop arrivals (at most --max-inflight\n"
+         << "                                   running); otherwise closed loop.\n"
+         << "  " << program << " --stress-queries [--threads N] [--iterations N]\n"
+         << "                                   Query one shared catalog from N threads and\n"
+         << "                                   check every answer.\n"
+         << "  " << program << " --shard-bench [--shards N] [--by hash|type] [--requests N]\n"
+         << "                                   Serve queries from N catalog shard processes\n"
+         << "                                   and report throughput scaling.\n";
+}
+
+int main(int argc, char* argv[]) {
+    if (argc == 1) return runPlanner();
+
+    string mode = argv[1];
+    if (mode == "--record" && argc == 3) {
+        // Replays run without the profile store, so recordings must too: saved
+        // profiles add defaults the recorded answers would otherwise rely on
+        setenv("WANDERPLAN_CUSTOMER_DB", "", 1);
+        SessionRecorder recorder(cin.rdbuf(), argv[2]);
+        if (!recorder.isOpen()) {
+            cerr << "Cannot write session log " << argv[2] << "\n";
+            return 1;
+        }
+        OutputDigest output(cout.rdbuf());
+        streambuf* originalIn = cin.rdbuf(&recorder);
+        streambuf* originalOut = cout.rdbuf(&output);
+        int status = runPlanner();
+        cout.flush();
+        cin.rdbuf(originalIn);
+        cout.rdbuf(originalOut);
+        recorder.finish(status, output.value());
+        return status;
+    }
+
+    if (mode == "--replay" && argc >= 3) {
+        SessionLog session;
+        if (!loadSessionLog(argv[2], session) || session.events.empty()) {
+            cerr << "Cannot read session log " << argv[2] << "\n";
+            return 1;
+        }
+        ReplayOptions options;
+        try {
+            for (int i = 3; i + 1 < argc; i += 2) {
+                string flag = argv[i];
+                if (flag == "--users") options.users = max(1, stoi(argv[i+1]));
+                else if (flag == "--sessions") options.sessions = max(1, stoi(argv[i+1]));
+                else if (flag == "--rate") options.rate = stod(argv[i+1]);
+                else if (flag == "--max-inflight") options.maxInFlight = max(1, stoi(argv[i+1]));
+                else if (flag == "--think-scale") options.thinkScale = stod(argv[i+1]);
+                else if (flag == "--timeout") options.timeoutSeconds = max(1, stoi(argv[i+1]));
+                else if (flag == "--seed") options.seed = stoul(argv[i+1]);
+                else throw invalid_argument(flag);
+            }
+            if ((argc - 3) % 2 != 0) throw invalid_argument("");
+        } catch (...) {
+            printUsage(argv[0]);
+            return 1;
+        }
+        signal(SIGPIPE, SIG_IGN);
+        SessionReplayer replayer("/proc/self/exe", session, options);
+        return replayer.run();
+    }
+
+    if (mode == "--stress-queries") {
+        int threads = max(4, (int)thread::hardware_concurrency()), iterations = 20000;
+        try {
+            if (argc % 2 != 0) throw invalid_argument("");
+            for (int i = 2; i + 1 < argc; i += 2) {
+                string flag = argv[i];
+                if (flag == "--threads") threads = max(1, stoi(argv[i+1]));
+                else if (flag == "--iterations") iterations = max(1, stoi(argv[i+1]));
+                else throw invalid_argument(flag);
+            }
+        } catch (...) {
+            printUsage(argv[0]);
+            return 1;
+        }
+        return runQueryStress(threads, iterations);
+    }
+
+    if (mode == "--shard-bench") {
+        int shards = 4, requests = 20000;
+        ShardKey key = SHARD_BY_HASH;
+        try {
+            if (argc % 2 != 0) throw invalid_argument("");
+            for (int i = 2; i + 1 < argc; i += 2) {
+                string flag = argv[i], value = argv[i+1];
+                if (flag == "--shards") shards = max(1, stoi(value));
+                else if (flag == "--requests") requests = max(1, stoi(value));
+                else if (flag == "--by" && (value == "hash" || value == "type"))
+                    key = (value == "type") ? SHARD_BY_TYPE : SHARD_BY_HASH;
+                else throw invalid_argument(flag);
+            }
+        } catch (...) {
+            printUsage(argv[0]);
+            return 1;
+        }
+        return runShardBenchmark(shards, key, requests);
+    }
+
+    printUsage(argv[0]);
+    return 1;
 }
\ No newline at end of file